@@ -21,6 +21,7 @@
 #include <QVBoxLayout>
 #include <QApplication>
 #include <QDesktopWidget>
+#include <QSet>
 
 DGUI_USE_NAMESPACE
 
@@ -534,20 +535,21 @@ void CScheduleView::updateSchedule()
     m_graphicsView->clearSchedule();
     DSchedule::List allInfo;
     DSchedule::List nonAllInfo;
+    //跨天日程在每天都有，按日程实例标识过滤
+    QSet<QString> scheduleIDs;
 
     QMap<QDate, DSchedule::List>::const_iterator _iterator = m_showSchedule.constBegin();
     for (; _iterator != m_showSchedule.constEnd(); ++_iterator) {
         for (int i = 0; i < _iterator->size(); ++i) {
-            if (_iterator.value().at(i)->allDay()) {
-                //过滤
-                if (!allInfo.contains(_iterator.value().at(i))) {
-                    allInfo.append(_iterator.value().at(i));
-                }
+            const DSchedule::Ptr &info = _iterator.value().at(i);
+            if (info.isNull() || scheduleIDs.contains(info->instanceIdentifier())) {
+                continue;
+            }
+            scheduleIDs.insert(info->instanceIdentifier());
+            if (info->allDay()) {
+                allInfo.append(info);
             } else {
-                //过滤
-                if (!nonAllInfo.contains(_iterator.value().at(i))) {
-                    nonAllInfo.append(_iterator.value().at(i));
-                }
+                nonAllInfo.append(info);
             }
         }
     }
@@ -67,7 +67,7 @@ DAccount::Ptr AccountItem::getAccount()
 }
 
 //获取日程
-QMap<QDate, DSchedule::List> AccountItem::getScheduleMap()
+DScheduleOccurrence::Map AccountItem::getScheduleMap()
 {
     return m_scheduleMap;
 }
@@ -402,7 +402,7 @@ void AccountItem::slotGetScheduleTypeListFinish(DScheduleType::List scheduleType
  * 获取日程数据完成事件
  * @param map 日程数据
  */
-void AccountItem::slotGetScheduleListFinish(QMap<QDate, DSchedule::List> map)
+void AccountItem::slotGetScheduleListFinish(DScheduleOccurrence::Map map)
 {
     m_scheduleMap = map;
     emit signalScheduleUpdate();
@@ -25,8 +25,8 @@ public:
     //获取帐户数据
     DAccount::Ptr getAccount();
 
-    //获取日程
-    QMap<QDate, DSchedule::List> getScheduleMap();
+    //获取日程，重复日程的实例只保存本次重复的时间
+    DScheduleOccurrence::Map getScheduleMap();
     QMap<QDate, DSchedule::List> getSearchScheduleMap();
 
     // 获取日程类型信息集
@@ -121,7 +121,7 @@ public slots:
     //获取日程类型数据完成事件
     void slotGetScheduleTypeListFinish(DScheduleType::List);
     //获取日程数据完成事件
-    void slotGetScheduleListFinish(QMap<QDate, DSchedule::List>);
+    void slotGetScheduleListFinish(DScheduleOccurrence::Map);
     //搜索日程数据完成事件
     void slotSearchScheduleListFinish(QMap<QDate, DSchedule::List>);
     //获取系统颜色完成
@@ -143,7 +143,7 @@ private:
     DTypeColor::List m_typeColorList;    //颜色数据
     DbusAccountRequest *m_dbusRequest = nullptr; //dbus请求实例
     //一年的日程信息
-    QMap<QDate, DSchedule::List> m_scheduleMap{};
+    DScheduleOccurrence::Map m_scheduleMap{};
     //搜索的日程信息
     QMap<QDate, DSchedule::List> m_searchedScheduleMap{};
 
@@ -114,6 +114,14 @@ QString LunarManager::getHuangLiShortName(const QDate &date)
 void LunarManager::queryLunarInfo(const QDate &startDate, const QDate &stopDate)
 {
     QMap<QDate, CaHuangLiDayInfo> lunarInfoMap;
+    //与按月获取一致，获取开始时间至结束时间所在月的完整数据
+    const QDate rangeStart(startDate.year(), startDate.month(), 1);
+    const QDate rangeStop = QDate(stopDate.year(), stopDate.month(), 1).addMonths(1).addDays(-1);
+    //优先一次获取整个范围的数据，旧版本后端不支持时按月获取
+    if (m_dbusRequest->getHuangLiRange(rangeStart, rangeStop, lunarInfoMap)) {
+        m_lunarInfoMap = lunarInfoMap;
+        return;
+    }
     CaHuangLiMonthInfo monthInfo;
     const int offsetMonth = (stopDate.year() - startDate.year()) * 12 + stopDate.month() - startDate.month();
     //获取开始时间至结束时间所在月的农历和节假日信息
@@ -140,13 +148,26 @@ void LunarManager::queryFestivalInfo(const QDate &startDate, const QDate &stopDa
 {
     QVector<FestivalInfo> festivallist{};
 
-    const int offsetMonth = (stopDate.year() - startDate.year()) * 12 + stopDate.month() - startDate.month();
-
-    for (int i = 0; i <= offsetMonth; ++i) {
+    //按年获取所在年份的全部节假日，旧版本后端不支持时按月获取
+    bool yearSupported = true;
+    for (int year = startDate.year(); year <= stopDate.year(); ++year) {
         FestivalInfo info;
-        QDate beginDate = startDate.addMonths(i);
-        if (getFestivalMonth(beginDate, info)) {
-            festivallist.push_back(info);
+        if (!m_dbusRequest->getFestivalYear(quint32(year), info)) {
+            yearSupported = false;
+            break;
+        }
+        festivallist.push_back(info);
+    }
+
+    if (!yearSupported) {
+        festivallist.clear();
+        const int offsetMonth = (stopDate.year() - startDate.year()) * 12 + stopDate.month() - startDate.month();
+        for (int i = 0; i <= offsetMonth; ++i) {
+            FestivalInfo info;
+            QDate beginDate = startDate.addMonths(i);
+            if (getFestivalMonth(beginDate, info)) {
+                festivallist.push_back(info);
+            }
         }
     }
 
@@ -154,6 +154,13 @@ QRectF CScheduleCoorManage::getDrawRegion(QDate date, QDateTime begintime, QDate
     return rect;
 }
 
+QRectF CScheduleCoorManage::getDrawRegion(QDate date, const CScheduleLayout::Item &item, int maxNum, int type)
+{
+    if (item.schedule.isNull())
+        return QRectF();
+    return getDrawRegion(date, item.schedule->dtStart(), item.schedule->dtEnd(), item.column + 1, item.columnCount, maxNum, type);
+}
+
 QRectF CScheduleCoorManage::getDrawRegionF(QDateTime begintime, QDateTime endtime)
 {
     QRectF rectf;
@@ -5,6 +5,8 @@
 #ifndef SCHEDULECOORMANAGE_H
 #define SCHEDULECOORMANAGE_H
 
+#include "schedulelayout.h"
+
 #include <QDate>
 #include <QDateTime>
 #include <QRect>
@@ -23,6 +25,8 @@ public:
     QRectF getDrawRegion(QDateTime begintime, QDateTime endtime);
     QRectF getDrawRegion(QDateTime begintime, QDateTime endtime, int index, int coount);
     QRectF getDrawRegion(QDate date, QDateTime begintime, QDateTime endtime, int index, int coount, int maxNum, int type = 0);
+    //根据CScheduleLayout计算的列布局获取日程绘制区域
+    QRectF getDrawRegion(QDate date, const CScheduleLayout::Item &item, int maxNum, int type = 0);
     QRectF getDrawRegionF(QDateTime begintime, QDateTime endtime);
     QRectF getAllDayDrawRegion(QDate begin, QDate end);
     QDateTime getDate(QPointF pos);
@@ -5,15 +5,36 @@
 #include "scheduledatamanage.h"
 #include "accountmanager.h"
 #include "cscheduleoperation.h"
-#include "accountmanager.h"
+#include "commondef.h"
 
 #include <QJsonArray>
 #include <QJsonDocument>
+#include <QTimer>
 
 CScheduleDataManage *CScheduleDataManage::m_vscheduleDataManage = nullptr;
 
-//
+//每个日程绘制时都会获取颜色，使用缓存避免遍历所有帐户的日程类型
 CSchedulesColor CScheduleDataManage::getScheduleColorByType(const QString &typeId)
+{
+    ++m_colorLookupCount;
+    //统计每一帧的查询次数，在本次绘制结束后输出
+    if (!m_frameLookupPending && ClientLogger().isDebugEnabled()) {
+        m_frameLookupPending = true;
+        const quint64 frameBegin = m_colorLookupCount - 1;
+        QTimer::singleShot(0, this, [this, frameBegin]() {
+            m_frameLookupPending = false;
+            qCDebug(ClientLogger) << "schedule color lookups per frame:" << m_colorLookupCount - frameBegin;
+        });
+    }
+
+    auto iter = m_scheduleColors.constFind(typeId);
+    if (iter == m_scheduleColors.constEnd()) {
+        iter = m_scheduleColors.insert(typeId, createScheduleColor(typeId));
+    }
+    return iter.value();
+}
+
+CSchedulesColor CScheduleDataManage::createScheduleColor(const QString &typeId)
 {
     CSchedulesColor color;
     DScheduleType::Ptr type = gAccountManager->getScheduleTypeByScheduleTypeId(typeId);
@@ -53,6 +74,12 @@ QColor CScheduleDataManage::getTextColor()
 void CScheduleDataManage::setTheMe(int type)
 {
     m_theme = type;
+    clearScheduleColor();
+}
+
+void CScheduleDataManage::clearScheduleColor()
+{
+    m_scheduleColors.clear();
 }
 
 CScheduleDataManage *CScheduleDataManage::getScheduleDataManage()
@@ -66,6 +93,9 @@ CScheduleDataManage *CScheduleDataManage::getScheduleDataManage()
 CScheduleDataManage::CScheduleDataManage(QObject *parent)
     : QObject(parent)
 {
+    //帐户增减或日程类型改变后颜色缓存失效
+    connect(gAccountManager, &AccountManager::signalAccountUpdate, this, &CScheduleDataManage::clearScheduleColor);
+    connect(gAccountManager, &AccountManager::signalScheduleTypeUpdate, this, &CScheduleDataManage::clearScheduleColor);
 }
 
 CScheduleDataManage::~CScheduleDataManage()
@@ -12,6 +12,7 @@
 #include <QThread>
 #include <QDate>
 #include <QMutex>
+#include <QHash>
 
 DGUI_USE_NAMESPACE
 struct CSchedulesColor {
@@ -29,6 +30,11 @@ public:
     static CScheduleDataManage *getScheduleDataManage();
     //根据日程类型ID获取颜色信息
     CSchedulesColor getScheduleColorByType(const QString &type);
+    //获取颜色信息的累计查询次数
+    quint64 getColorLookupCount() const
+    {
+        return m_colorLookupCount;
+    }
     static QColor getSystemActiveColor();
     static QColor getTextColor();
     void setTheMe(int type = 0);
@@ -39,8 +45,16 @@ public:
 private:
     explicit CScheduleDataManage(QObject *parent = nullptr);
     ~CScheduleDataManage();
+    //根据日程类型ID查询日程类型并计算颜色信息
+    static CSchedulesColor createScheduleColor(const QString &typeId);
+    //清空颜色缓存，日程类型或主题改变后重新计算
+    void clearScheduleColor();
 private:
     int m_theme = 0;
+    //日程类型ID对应的颜色信息
+    QHash<QString, CSchedulesColor> m_scheduleColors;
+    quint64 m_colorLookupCount = 0;
+    bool m_frameLookupPending = false;
     static CScheduleDataManage *m_vscheduleDataManage;
 };
 #endif // SCHEDULEVIEW_H
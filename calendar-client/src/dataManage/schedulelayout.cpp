@@ -0,0 +1,81 @@
+// SPDX-FileCopyrightText: 2019 - 2022 UnionTech Software Technology Co., Ltd.
+//
+// SPDX-License-Identifier: LGPL-3.0-or-later
+
+#include "schedulelayout.h"
+
+#include <algorithm>
+#include <functional>
+#include <queue>
+#include <utility>
+
+QVector<CScheduleLayout::Item> CScheduleLayout::layout(const DSchedule::List &scheduleList, int minDuration)
+{
+    QVector<Item> items;
+    items.reserve(scheduleList.size());
+    for (const DSchedule::Ptr &schedule : scheduleList) {
+        if (schedule.isNull()) {
+            continue;
+        }
+        Item item;
+        item.schedule = schedule;
+        item.beginTime = schedule->dtStart();
+        item.endTime = schedule->dtEnd();
+        //同一天内时长不足最小显示时长的日程按最小显示时长计算
+        if (item.beginTime.date().daysTo(item.endTime.date()) == 0 && item.beginTime.time().secsTo(item.endTime.time()) < minDuration) {
+            item.endTime = item.beginTime.addSecs(minDuration);
+        }
+        //结束于零点的日程不与第二天零点开始的日程重叠
+        if (item.endTime.time().hour() == 0 && item.endTime.time().second() == 0) {
+            item.endTime = item.endTime.addSecs(-1);
+        }
+        items.append(item);
+    }
+    std::stable_sort(items.begin(), items.end(), [](const Item &item1, const Item &item2) {
+        return item1.beginTime < item2.beginTime;
+    });
+
+    //QDateTime比较时需要时区转换，预先转为毫秒数
+    QVector<qint64> endMSecs(items.size());
+    for (int i = 0; i < items.size(); ++i) {
+        endMSecs[i] = items.at(i).endTime.toMSecsSinceEpoch();
+    }
+    typedef std::pair<qint64, int> ActiveItem; //结束时间，所在列
+    std::priority_queue<ActiveItem, std::vector<ActiveItem>, std::greater<ActiveItem>> activeItems;
+    std::priority_queue<int, std::vector<int>, std::greater<int>> freeColumns;
+    int group = -1;
+    int groupBegin = 0;
+    int columnCount = 0;
+    for (int i = 0; i < items.size(); ++i) {
+        const qint64 beginMSecs = items.at(i).beginTime.toMSecsSinceEpoch();
+        //开始时间等于结束时间也算重叠，释放已经结束的日程所在的列
+        while (!activeItems.empty() && activeItems.top().first < beginMSecs) {
+            freeColumns.push(activeItems.top().second);
+            activeItems.pop();
+        }
+        //没有未结束的日程时开始新的一组
+        if (activeItems.empty()) {
+            for (int j = groupBegin; j < i; ++j) {
+                items[j].columnCount = columnCount;
+            }
+            ++group;
+            groupBegin = i;
+            columnCount = 0;
+            freeColumns = decltype(freeColumns)();
+        }
+        int column = columnCount;
+        if (freeColumns.empty()) {
+            ++columnCount;
+        } else {
+            column = freeColumns.top();
+            freeColumns.pop();
+        }
+        items[i].column = column;
+        items[i].group = group;
+        activeItems.push(ActiveItem(endMSecs.at(i), column));
+    }
+    for (int j = groupBegin; j < items.size(); ++j) {
+        items[j].columnCount = columnCount;
+    }
+    return items;
+}
@@ -0,0 +1,39 @@
+// SPDX-FileCopyrightText: 2019 - 2022 UnionTech Software Technology Co., Ltd.
+//
+// SPDX-License-Identifier: LGPL-3.0-or-later
+
+#ifndef SCHEDULELAYOUT_H
+#define SCHEDULELAYOUT_H
+
+#include "dschedule.h"
+
+#include <QDateTime>
+#include <QVector>
+
+/**
+ * @brief The CScheduleLayout class     日/周视图时间轴上重叠日程的布局
+ * 日程按开始时间排序后扫描一遍，相互重叠的日程组成一组，
+ * 每个日程分配组内最小的空闲列，组内列数为同时重叠的最大日程数
+ */
+class CScheduleLayout
+{
+public:
+    struct Item {
+        DSchedule::Ptr schedule;
+        QDateTime beginTime;
+        QDateTime endTime;  //按最小显示时长调整后的结束时间
+        int column = 0;     //所在列，从0开始
+        int columnCount = 1;//所在组的列数
+        int group = 0;      //所在组，从0开始
+    };
+
+    /**
+     * @brief layout            计算日程的列布局
+     * @param scheduleList      非全天日程，开始时间相同的日程保持传入的顺序
+     * @param minDuration       日程的最小显示时长，单位秒
+     * @return                  按开始时间排序的布局信息
+     */
+    static QVector<Item> layout(const DSchedule::List &scheduleList, int minDuration);
+};
+
+#endif // SCHEDULELAYOUT_H
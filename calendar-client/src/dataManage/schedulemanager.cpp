@@ -47,20 +47,19 @@ void ScheduleManager::resetSchedule(const QDateTime &start, const QDateTime &end
 void ScheduleManager::updateSchedule()
 {
     m_scheduleMap.clear();
+    m_materializedMap.clear();
     if (nullptr != gAccountManager->getLocalAccountItem()) {
         m_scheduleMap = gAccountManager->getLocalAccountItem()->getScheduleMap();
     }
 
     if (nullptr != gAccountManager->getUnionAccountItem()) {
-        QMap<QDate, DSchedule::List> scheduleMap = gAccountManager->getUnionAccountItem()->getScheduleMap();
+        DScheduleOccurrence::Map scheduleMap = gAccountManager->getUnionAccountItem()->getScheduleMap();
         if (m_scheduleMap.size() == 0) {
             m_scheduleMap = scheduleMap;
         } else {
             auto iterator = scheduleMap.begin();
             while (iterator != scheduleMap.end()) {
-                DSchedule::List list = m_scheduleMap[iterator.key()];
-                list.append(iterator.value());
-                m_scheduleMap[iterator.key()] = list;
+                m_scheduleMap[iterator.key()].append(iterator.value());
                 iterator++;
             }
         }
@@ -95,6 +94,23 @@ void ScheduleManager::updateSearchSchedule()
     emit signalSearchScheduleUpdate();
 }
 
+/**
+ * @brief ScheduleManager::materializedSchedules
+ * 获取某天实例对应的完整日程，重复日程的实例只在第一次获取时复制原日程
+ * @param date 日期
+ * @return
+ */
+DSchedule::List ScheduleManager::materializedSchedules(const QDate &date) const
+{
+    auto iter = m_materializedMap.constFind(date);
+    if (iter != m_materializedMap.constEnd()) {
+        return iter.value();
+    }
+    DSchedule::List scheduleList = DScheduleOccurrence::toScheduleList(m_scheduleMap.value(date));
+    m_materializedMap.insert(date, scheduleList);
+    return scheduleList;
+}
+
 /**
  * @brief ScheduleManager::slotScheduleUpdate
  * 日程数据更新事件
@@ -116,7 +132,11 @@ void ScheduleManager::slotSearchUpdate()
  */
 QMap<QDate, DSchedule::List> ScheduleManager::getAllScheduleMap()
 {
-    return m_scheduleMap;
+    QMap<QDate, DSchedule::List> scheduleMap;
+    for (auto iter = m_scheduleMap.constBegin(); iter != m_scheduleMap.constEnd(); ++iter) {
+        scheduleMap.insert(iter.key(), materializedSchedules(iter.key()));
+    }
+    return scheduleMap;
 }
 
 /**
@@ -128,19 +148,13 @@ QMap<QDate, DSchedule::List> ScheduleManager::getAllScheduleMap()
  */
 QMap<QDate, DSchedule::List> ScheduleManager::getScheduleMap(const QDate &startDate, const QDate &stopDate) const
 {
-    QMap<QDate, DSchedule::List> map;
-    QDate date = startDate;
-    while (date != stopDate) {
-        if (m_scheduleMap.contains(date)) {
-            map[date] = m_scheduleMap[date];
-        }
-        date = date.addDays(1);
-    }
-
-    if (m_scheduleMap.contains(date)) {
-        map[date] = m_scheduleMap[date];
+    //只为范围内的实例生成完整日程，已生成的直接复用
+    QMap<QDate, DSchedule::List> scheduleMap;
+    auto iter = m_scheduleMap.lowerBound(startDate);
+    for (; iter != m_scheduleMap.constEnd() && iter.key() <= stopDate; ++iter) {
+        scheduleMap.insert(iter.key(), materializedSchedules(iter.key()));
     }
-    return map;
+    return scheduleMap;
 }
 
 /**
@@ -203,10 +217,10 @@ QSet<QDate> ScheduleManager::getAllSearchedScheduleDate()
  */
 DSchedule::List ScheduleManager::getScheduleByDay(QDate date)
 {
-    if (m_scheduleMap.contains(date)) {
-        return m_scheduleMap[date];
+    if (!m_scheduleMap.contains(date)) {
+        return DSchedule::List();
     }
-    return DSchedule::List();
+    return materializedSchedules(date);
 }
 
 /**
@@ -64,9 +64,12 @@ private:
     void updateSchedule();
     //更新被搜索的日程
     void updateSearchSchedule();
+    //获取某一天实例对应的完整日程，生成后缓存到日程数据更新为止
+    DSchedule::List materializedSchedules(const QDate &date) const;
 
 private:
-    QMap<QDate, DSchedule::List> m_scheduleMap;     //一年的日程数据
+    DScheduleOccurrence::Map m_scheduleMap;     //一年的日程实例，获取时再生成完整日程
+    mutable DSchedule::Map m_materializedMap;    //已生成的完整日程，同一实例多次获取返回同一日程
     QMap<QDate, DSchedule::List> m_searchScheduleMap;   //被搜索的日程数据
     DScheduleQueryPar::Ptr m_searchQuery;   //上一次搜索的条件
 
@@ -222,7 +222,8 @@ void DbusAccountRequest::querySchedulesWithParameter(const DScheduleQueryPar::Pt
         m_priParams = params;
     }
     QString jsonStr = DScheduleQueryPar::toJsonString(params);
-    asyncCall("querySchedulesWithParameter", callName, QVariant(jsonStr));
+    //重复日程由服务端展开，避免在界面线程中计算
+    asyncCall("queryScheduleOccurrences", callName, QVariant(jsonStr), QVariant(0), QVariant(0));
 }
 
 bool DbusAccountRequest::querySchedulesByExternal(const DScheduleQueryPar::Ptr &params, QString &json)
@@ -280,14 +281,13 @@ void DbusAccountRequest::slotCallFinished(CDBusPendingCallWatcher *call)
                 ret = 2;
             }
         } else if (call->getmember() == "querySchedulesWithParameter") {
-            QDBusPendingReply<QString> reply = *call;
-            QString str = reply.argumentAt<0>();
-            QMap<QDate, DSchedule::List> map = DSchedule::fromQueryResult(str);
+            QDBusPendingReply<QByteArray> reply = *call;
+            //只保存实例的时间，显示时再生成完整日程
+            DScheduleOccurrence::Map map = DScheduleOccurrence::fromOccurrenceResult(reply.argumentAt<0>());
             emit signalGetScheduleListFinish(map);
         } else if (call->getmember() == "searchSchedulesWithParameter") {
-            QDBusPendingReply<QString> reply = *call;
-            QString str = reply.argumentAt<0>();
-            QMap<QDate, DSchedule::List> map = DSchedule::fromQueryResult(str);
+            QDBusPendingReply<QByteArray> reply = *call;
+            QMap<QDate, DSchedule::List> map = DSchedule::fromOccurrenceResult(reply.argumentAt<0>());
             emit signalSearchScheduleListFinish(map);
         } else if (call->getmember() == "getSysColors") {
             QDBusPendingReply<QString> reply = *call;
@@ -8,6 +8,7 @@
 #include "dbusrequestbase.h"
 #include "daccount.h"
 #include "dschedule.h"
+#include "dscheduleoccurrence.h"
 #include "dscheduletype.h"
 #include "dtypecolor.h"
 #include "dschedulequerypar.h"
@@ -134,7 +135,7 @@ public:
 signals:
     void signalGetAccountInfoFinish(DAccount::Ptr);
     void signalGetScheduleTypeListFinish(DScheduleType::List);
-    void signalGetScheduleListFinish(QMap<QDate, DSchedule::List>);
+    void signalGetScheduleListFinish(DScheduleOccurrence::Map);
     void signalSearchScheduleListFinish(QMap<QDate, DSchedule::List>);
     void signalGetSysColorsFinish(DTypeColor::List);
     void signalDtLastUpdate(QString);
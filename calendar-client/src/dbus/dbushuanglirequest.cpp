@@ -25,7 +25,22 @@ DbusHuangLiRequest::DbusHuangLiRequest(QObject *parent)
 bool DbusHuangLiRequest::getFestivalMonth(quint32 year, quint32 month, FestivalInfo &festivalInfo)
 {
     QDBusPendingReply<QString> reply = call("getFestivalMonth", QVariant(year), QVariant(month));
+    return festivalReplyToInfo(reply, year, festivalInfo);
+}
+
+/**
+ * @brief DbusHuangLiRequest::getFestivalYear
+ * 按年获取节假日信息，用于年视图一次获取全年数据
+ * @param year
+ */
+bool DbusHuangLiRequest::getFestivalYear(quint32 year, FestivalInfo &festivalInfo)
+{
+    QDBusPendingReply<QString> reply = call("getFestivalYear", QVariant(year));
+    return festivalReplyToInfo(reply, year, festivalInfo);
+}
 
+bool DbusHuangLiRequest::festivalReplyToInfo(QDBusPendingReply<QString> &reply, quint32 year, FestivalInfo &festivalInfo)
+{
     if (reply.isError()) {
         qCWarning(ClientLogger) << reply.error().message();
         return false;
@@ -128,6 +143,44 @@ bool DbusHuangLiRequest::getHuangLiMonth(quint32 year,
     return infoIsVaild;
 }
 
+/**
+ * @brief DbusHuangLiRequest::getHuangLiRange
+ * 按时间范围获取每天的黄历信息，一次请求获取整个范围的数据
+ * @param startDate 开始日期
+ * @param stopDate 结束日期，包含该天
+ * @param infoMap 数据保存位置
+ */
+bool DbusHuangLiRequest::getHuangLiRange(const QDate &startDate,
+                                         const QDate &stopDate,
+                                         QMap<QDate, CaHuangLiDayInfo> &infoMap)
+{
+    QDBusPendingReply<QString> reply =
+        call("getHuangLiRange", QVariant(startDate.toString("yyyy-MM-dd")), QVariant(stopDate.toString("yyyy-MM-dd")));
+    if (reply.isError()) {
+        qCWarning(ClientLogger) << reply.error().message();
+        return false;
+    }
+    QString json = reply.argumentAt<0>();
+    QJsonParseError json_error;
+    QJsonDocument jsonDoc(QJsonDocument::fromJson(json.toUtf8(), &json_error));
+    if (json_error.error != QJsonParseError::NoError) {
+        return false;
+    }
+    QJsonObject rootObj = jsonDoc.object();
+    QJsonArray subArray = rootObj.value("Datas").toArray();
+    //范围无效时服务端不返回数据
+    if (subArray.isEmpty()) {
+        return false;
+    }
+    QDate date = QDate::fromString(rootObj.value("StartDate").toString(), "yyyy-MM-dd");
+    for (int i = 0; i < subArray.size(); i++) {
+        CaHuangLiDayInfo huangliday;
+        huangliday.jsonObjectToInfo(subArray.at(i).toObject());
+        infoMap[date.addDays(i)] = huangliday;
+    }
+    return true;
+}
+
 /**
  * @brief DbusHuangLiRequest::getLunarInfoBySolar
  * 获取农历信息
@@ -18,10 +18,14 @@ public:
 
     //按月获取节假日信息
     bool getFestivalMonth(quint32 year, quint32 month, FestivalInfo&);
+    //按年获取节假日信息
+    bool getFestivalYear(quint32 year, FestivalInfo&);
     //按天获取黄历信息
     bool getHuangLiDay(quint32 year, quint32 month, quint32 day, CaHuangLiDayInfo &);
     //按月获取黄历信息
     bool getHuangLiMonth(quint32 year, quint32 month, bool fill, CaHuangLiMonthInfo &);
+    //按时间范围获取每天的黄历信息
+    bool getHuangLiRange(const QDate &startDate, const QDate &stopDate, QMap<QDate, CaHuangLiDayInfo> &);
     //获取农历信息
     void getLunarInfoBySolar(quint32 year, quint32 month, quint32 day);
     //获取农历月日程
@@ -32,6 +36,10 @@ signals:
 public slots:
     void slotCallFinished(CDBusPendingCallWatcher*) override;
 
+private:
+    //解析节假日请求的返回数据
+    bool festivalReplyToInfo(QDBusPendingReply<QString> &reply, quint32 year, FestivalInfo &festivalInfo);
+
 };
 
 #endif // DBUSHUANGLIREQUEST_H
@@ -183,44 +183,31 @@ void CGraphicsView::upDateInfoShow(const CGraphicsView::DragStatus &status, cons
         std::sort(currentInfo.begin(), currentInfo.end());
         if (currentInfo.size() > 0) {
             m_InfoMap[currentDate] = currentInfo;
-            QList<ScheduleclassificationInfo> info;
-            scheduleClassificationType(currentInfo, info);
-
-            for (int m = 0; m < info.count(); m++) {
-                int tNum = info.at(m).vData.count();
-                //如果为周视图则要显示一个位置显示日程的数目
-                if (m_viewPos == WeekPos) {
-                    if (tNum > m_sMaxNum) {
-                        tNum = m_sMaxNum;
-                        for (int n = 0; n < tNum - 1; n++) {
-                            addScheduleItem(info.at(m).vData.at(n), currentDate, n + 1,
-                                            tNum, 0, m_viewType, m_sMaxNum);
-                        }
-                        //添加“...”item
-                        int index = tNum - 2;
-                        if (index < 0) {
-                            qCWarning(ClientLogger) << "week view create error,tNum -2 :" << index;
-                            index = 1;
-                        }
-                        DSchedule::Ptr tdetaliinfo(info.at(m).vData.at(index)->clone());
-                        tdetaliinfo->setSummary("1");
-                        //如果为"..."则设置类型为other，在获取颜色时会对其进行判断
-                        tdetaliinfo->setScheduleTypeID("other");
-                        addScheduleItem(tdetaliinfo, currentDate, tNum, tNum, 1,
-                                        m_viewType, m_sMaxNum);
-                    } else {
-                        for (int n = 0; n < tNum; n++) {
-                            addScheduleItem(info.at(m).vData.at(n), currentDate, n + 1,
-                                            tNum, 0, m_viewType, m_sMaxNum);
-                        }
-                    }
-                } else {
-                    for (int n = 0; n < tNum; n++) {
-                        addScheduleItem(info.at(m).vData.at(n), currentDate, n + 1,
-                                        tNum, 0, m_viewType, m_sMaxNum);
-                    }
+            const QVector<CScheduleLayout::Item> layoutItems = CScheduleLayout::layout(currentInfo, m_minTime);
+            //周视图中列数超过最大显示数量的组，最后一列显示为"..."，时间范围覆盖组内所有隐藏的日程
+            QMap<int, QPair<DSchedule::Ptr, QDateTime>> moreInfo;
+            for (const CScheduleLayout::Item &item : layoutItems) {
+                if (m_viewPos != WeekPos || item.columnCount <= m_sMaxNum) {
+                    addScheduleItem(item, currentDate);
+                } else if (item.column < m_sMaxNum - 1) {
+                    addScheduleItem(item.schedule, currentDate, item.column + 1,
+                                    m_sMaxNum, 0, m_viewType, m_sMaxNum);
+                } else if (!moreInfo.contains(item.group)) {
+                    moreInfo.insert(item.group, qMakePair(item.schedule, item.schedule->dtEnd()));
+                } else if (item.schedule->dtEnd() > moreInfo[item.group].second) {
+                    moreInfo[item.group].second = item.schedule->dtEnd();
                 }
             }
+            //添加“...”item
+            for (auto iter = moreInfo.constBegin(); iter != moreInfo.constEnd(); ++iter) {
+                DSchedule::Ptr tdetaliinfo(iter->first->clone());
+                tdetaliinfo->setDtEnd(iter->second);
+                tdetaliinfo->setSummary("1");
+                //如果为"..."则设置类型为other，在获取颜色时会对其进行判断
+                tdetaliinfo->setScheduleTypeID("other");
+                addScheduleItem(tdetaliinfo, currentDate, m_sMaxNum, m_sMaxNum, 1,
+                                m_viewType, m_sMaxNum);
+            }
         }
     }
     //更新每个背景上的日程标签
@@ -273,6 +260,15 @@ void CGraphicsView::addScheduleItem(const DSchedule::Ptr &info, QDate date, int
     m_vScheduleItem.append(item);
 }
 
+void CGraphicsView::addScheduleItem(const CScheduleLayout::Item &item, QDate date)
+{
+    CScheduleItem *scheduleItem = new CScheduleItem(
+        m_coorManage->getDrawRegion(date, item, m_sMaxNum, m_viewType), nullptr, 0);
+    m_Scene->addItem(scheduleItem);
+    scheduleItem->setData(item.schedule, date, item.columnCount);
+    m_vScheduleItem.append(scheduleItem);
+}
+
 /**
  * @brief CGraphicsView::setSelectSearchSchedule        设置搜索选中日程
  * @param info
@@ -304,63 +300,6 @@ void CGraphicsView::clearSchedule()
     m_updateDflag = true;
 }
 
-void CGraphicsView::scheduleClassificationType(DSchedule::List &scheduleInfolist, QList<ScheduleclassificationInfo> &info)
-{
-    DSchedule::List schedulelist = scheduleInfolist;
-    if (schedulelist.isEmpty())
-        return;
-
-    info.clear();
-    std::sort(schedulelist.begin(), schedulelist.end());
-    QVector<int> containIndex;
-
-    for (int k = 0; k < schedulelist.count(); k++) {
-        QDateTime endTime = schedulelist.at(k)->dtEnd();
-        QDateTime begTime = schedulelist.at(k)->dtStart();
-
-        if (begTime.date().daysTo(endTime.date()) == 0 && begTime.time().secsTo(endTime.time()) < m_minTime) {
-            endTime = begTime.addSecs(m_minTime);
-        }
-        if (endTime.time().hour() == 0 && endTime.time().second() == 0) {
-            endTime = endTime.addSecs(-1);
-        }
-        containIndex.clear();
-
-        for (int i = 0; i < info.count(); i++) {
-            if ((schedulelist.at(k)->dtStart() >= info.at(i).begindate && schedulelist.at(k)->dtStart() <= info.at(i).enddate) || (endTime >= info.at(i).begindate && endTime <= info.at(i).enddate)) {
-                containIndex.append(i);
-            }
-        }
-        if (containIndex.count() == 0) {
-            ScheduleclassificationInfo firstschedule;
-            firstschedule.begindate = schedulelist.at(k)->dtStart();
-            firstschedule.enddate = endTime;
-            firstschedule.vData.append(schedulelist.at(k));
-            info.append(firstschedule);
-        } else {
-            ScheduleclassificationInfo &scheduleInfo = info[containIndex.at(0)];
-            int index = 0;
-
-            for (int i = 1; i < containIndex.count(); ++i) {
-                index = containIndex.at(i);
-                if (info.at(index).begindate < scheduleInfo.begindate)
-                    scheduleInfo.begindate = info.at(index).begindate;
-                if (info.at(index).enddate > scheduleInfo.enddate)
-                    scheduleInfo.enddate = info.at(index).enddate;
-                scheduleInfo.vData.append(info.at(index).vData);
-            }
-            for (int i = containIndex.count() - 1; i > 0; --i) {
-                info.removeAt(containIndex.at(i));
-            }
-            if (schedulelist.at(k)->dtStart() < scheduleInfo.begindate)
-                scheduleInfo.begindate = schedulelist.at(k)->dtStart();
-            if (endTime > scheduleInfo.enddate)
-                scheduleInfo.enddate = endTime;
-            scheduleInfo.vData.append(schedulelist.at(k));
-        }
-    }
-}
-
 void CGraphicsView::mouseDoubleClickEvent(QMouseEvent *event)
 {
     emit signalScheduleShow(false);
@@ -6,6 +6,7 @@
 #define GRAPHICSVIEW_H
 
 #include "dschedule.h"
+#include "schedulelayout.h"
 #include "draginfographicsview.h"
 #include "graphicsItem/cweekdaybackgrounditem.h"
 #include "cweekdaygraphicsview.h"
@@ -19,13 +20,6 @@
 
 DWIDGET_USE_NAMESPACE
 
-typedef struct _tagScheduleclassificationInfo {
-    QDateTime begindate;
-    QDateTime enddate;
-    DSchedule::List vData;
-
-} ScheduleclassificationInfo;
-
 class CScheduleCoorManage;
 class CScheduleItem;
 class CGraphicsView : public CWeekDayGraphicsview
@@ -43,6 +37,8 @@ public:
     void setCurrentDate(const QDateTime &currentDate);
     void setInfo(const DSchedule::List &info);
     void addScheduleItem(const DSchedule::Ptr &info, QDate date, int index, int totalNum, int type, int viewtype, int maxnum);
+    //按布局信息添加日程
+    void addScheduleItem(const CScheduleLayout::Item &item, QDate date);
     //设置搜索选中日程
     void setSelectSearchSchedule(const DSchedule::Ptr &info) override;
     void clearSchedule();
@@ -57,7 +53,6 @@ public:
     }
     void keepCenterOnScene();
 
-    void scheduleClassificationType(DSchedule::List &scheduleInfolist, QList<ScheduleclassificationInfo> &info);
     void mouseDoubleClickEvent(QMouseEvent *event) override;
     void mousePressEvent(QMouseEvent *event) override;
     void mouseMoveEvent(QMouseEvent *event) override;
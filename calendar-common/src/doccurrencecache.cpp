@@ -0,0 +1,146 @@
+// SPDX-FileCopyrightText: 2019 - 2022 UnionTech Software Technology Co., Ltd.
+//
+// SPDX-License-Identifier: LGPL-3.0-or-later
+
+#include "doccurrencecache.h"
+#include "dschedule.h"
+
+#include "recurrence.h"
+
+#include <QMutexLocker>
+
+//时间转为带时区的字符串，用于拼接缓存键
+static QByteArray dtKey(const QDateTime &dateTime)
+{
+    return dateTime.toString(Qt::ISODateWithMs).toUtf8() + ' ' + dateTime.timeZone().id();
+}
+
+//整数列表追加到缓存键，列表为空时不追加
+static void appendInts(QByteArray &key, char tag, const QList<int> &list)
+{
+    if (list.isEmpty()) {
+        return;
+    }
+    key.append(tag);
+    foreach (int value, list) {
+        key.append(QByteArray::number(value)).append(',');
+    }
+}
+
+//重复规则的各字段追加到缓存键
+static void appendRule(QByteArray &key, char tag, const KCalendarCore::RecurrenceRule *rule)
+{
+    key.append(tag);
+    key.append(QByteArray::number(rule->recurrenceType())).append('/');
+    key.append(QByteArray::number(rule->frequency())).append('/');
+    key.append(QByteArray::number(rule->duration())).append('/');
+    //按次数结束时获取结束时间需要展开规则，次数已经能够区分
+    if (rule->duration() == 0) {
+        key.append(dtKey(rule->endDt()));
+    }
+    key.append('/').append(dtKey(rule->startDt()));
+    key.append('/').append(QByteArray::number(rule->weekStart())).append(rule->allDay() ? '1' : '0');
+    appendInts(key, 's', rule->bySeconds());
+    appendInts(key, 'i', rule->byMinutes());
+    appendInts(key, 'h', rule->byHours());
+    if (!rule->byDays().isEmpty()) {
+        key.append('w');
+        foreach (auto &dayPos, rule->byDays()) {
+            key.append(QByteArray::number(dayPos.pos())).append(':').append(QByteArray::number(dayPos.day())).append(',');
+        }
+    }
+    appendInts(key, 'd', rule->byMonthDays());
+    appendInts(key, 'y', rule->byYearDays());
+    appendInts(key, 'n', rule->byWeekNumbers());
+    appendInts(key, 'm', rule->byMonths());
+    appendInts(key, 'p', rule->bySetPos());
+    key.append(';');
+}
+
+DOccurrenceCache::DOccurrenceCache(int maxCost)
+    : m_cache(maxCost)
+{
+}
+
+DOccurrenceCache *DOccurrenceCache::instance()
+{
+    static DOccurrenceCache occurrenceCache;
+    return &occurrenceCache;
+}
+
+QByteArray DOccurrenceCache::cacheKey(const DSchedule &schedule, const QDateTime &dtStart, const QDateTime &dtEnd)
+{
+    QByteArray key = schedule.uid().toUtf8();
+    key.append('|').append(dtKey(schedule.lastModified()));
+    key.append('|').append(QByteArray::number(schedule.revision()));
+    key.append('|').append(dtKey(schedule.dtStart()));
+    key.append('|').append(dtKey(schedule.dtEnd()));
+    key.append('|').append(schedule.allDay() ? '1' : '0').append(schedule.lunnar() ? '1' : '0');
+    key.append('|');
+    //直接使用重复规则和例外日期的字段，不再通过libical生成RRULE字符串
+    KCalendarCore::Recurrence *recurrence = schedule.recurrence();
+    foreach (auto rule, recurrence->rRules()) {
+        appendRule(key, 'R', rule);
+    }
+    foreach (auto rule, recurrence->exRules()) {
+        appendRule(key, 'X', rule);
+    }
+    foreach (auto &dt, recurrence->rDateTimes()) {
+        key.append('r').append(dtKey(dt)).append(',');
+    }
+    foreach (auto &date, recurrence->rDates()) {
+        key.append('r').append(QByteArray::number(date.toJulianDay())).append(',');
+    }
+    foreach (auto &dt, recurrence->exDateTimes()) {
+        key.append('x').append(dtKey(dt)).append(',');
+    }
+    foreach (auto &date, recurrence->exDates()) {
+        key.append('x').append(QByteArray::number(date.toJulianDay())).append(',');
+    }
+    key.append('|').append(dtKey(dtStart));
+    key.append('|').append(dtKey(dtEnd));
+    return key;
+}
+
+void DOccurrenceCache::setMaxCost(int maxCost)
+{
+    QMutexLocker locker(&m_mutex);
+    m_cache.setMaxCost(maxCost);
+}
+
+bool DOccurrenceCache::value(const QByteArray &key, QList<QDateTime> &dtList)
+{
+    QMutexLocker locker(&m_mutex);
+    QList<QDateTime> *cacheList = m_cache.object(key);
+    if (cacheList == nullptr) {
+        ++m_misses;
+        return false;
+    }
+    ++m_hits;
+    dtList = *cacheList;
+    return true;
+}
+
+void DOccurrenceCache::insert(const QByteArray &key, const QList<QDateTime> &dtList)
+{
+    QMutexLocker locker(&m_mutex);
+    m_cache.insert(key, new QList<QDateTime>(dtList), dtList.size() + 1);
+}
+
+void DOccurrenceCache::clear()
+{
+    QMutexLocker locker(&m_mutex);
+    m_cache.clear();
+}
+
+QJsonObject DOccurrenceCache::toJsonObject() const
+{
+    QMutexLocker locker(&m_mutex);
+    QJsonObject rootObj;
+    rootObj.insert("capacity", m_cache.maxCost());
+    rootObj.insert("count", m_cache.count());
+    rootObj.insert("cost", m_cache.totalCost());
+    rootObj.insert("hits", static_cast<qint64>(m_hits));
+    rootObj.insert("misses", static_cast<qint64>(m_misses));
+    return rootObj;
+}
@@ -0,0 +1,56 @@
+// SPDX-FileCopyrightText: 2019 - 2022 UnionTech Software Technology Co., Ltd.
+//
+// SPDX-License-Identifier: LGPL-3.0-or-later
+
+#ifndef DOCCURRENCECACHE_H
+#define DOCCURRENCECACHE_H
+
+#include <QCache>
+#include <QMutex>
+#include <QDateTime>
+#include <QJsonObject>
+
+class DSchedule;
+
+//重复日程实例时间缓存，进程内共享
+//以日程id、修改时间、版本、开始结束时间、重复规则字段和查询范围为键，缓存范围内每个实例的开始时间
+//重复规则或例外日期修改后键随之变化，不会命中旧数据
+class DOccurrenceCache
+{
+public:
+    static DOccurrenceCache *instance();
+
+    /**
+     * @brief cacheKey      生成重复日程在查询范围内的缓存键
+     * @param schedule      重复日程
+     * @param dtStart       查询开始时间
+     * @param dtEnd         查询结束时间
+     */
+    static QByteArray cacheKey(const DSchedule &schedule, const QDateTime &dtStart, const QDateTime &dtEnd);
+
+    /**
+     * @brief setMaxCost    设置缓存容量，按缓存的实例时间数量计算
+     * 默认容量较小，需要大量展开重复日程的进程在启动时按需设置
+     */
+    void setMaxCost(int maxCost);
+
+    //获取缓存的实例开始时间，未命中时返回false
+    bool value(const QByteArray &key, QList<QDateTime> &dtList);
+    void insert(const QByteArray &key, const QList<QDateTime> &dtList);
+    void clear();
+
+    //缓存统计信息，包含容量、数量、命中和未命中次数
+    QJsonObject toJsonObject() const;
+
+private:
+    //容量按缓存的实例时间数量计算
+    explicit DOccurrenceCache(int maxCost = 20000);
+
+private:
+    mutable QMutex m_mutex;
+    QCache<QByteArray, QList<QDateTime>> m_cache;
+    quint64 m_hits = 0;
+    quint64 m_misses = 0;
+};
+
+#endif // DOCCURRENCECACHE_H
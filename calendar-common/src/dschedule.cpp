@@ -4,7 +4,7 @@
 
 #include "dschedule.h"
 #include "commondef.h"
-#include "lunarandfestival/lunardateinfo.h"
+#include "dscheduleoccurrence.h"
 
 #include "icalformat.h"
 #include "memorycalendar.h"
@@ -12,12 +12,21 @@
 #include "commondef.h"
 
 #include <QtDBus/QtDBus>
+#include <QDataStream>
+#include <QtConcurrent>
 
 #define Duration_Min 60
 #define Duration_Hour 60 * 60
 #define Duration_Day 24 * 60 * 60
 #define Duration_Week 7 * 24 * 60 * 60
 
+//二进制数据标识及版本，格式变化时需要修改版本号，旧版本数据会被丢弃并重新从ics解析
+static const quint32 BinaryMagic = 0x44534348;
+static const quint32 BinaryVersion = 1;
+//日程集二进制数据标识及版本
+static const quint32 ListBinaryMagic = 0x4453434C;
+static const quint32 ListBinaryVersion = 1;
+
 DSchedule::DSchedule()
     : KCalendarCore::Event()
     , m_fileName("")
@@ -294,6 +303,44 @@ QString DSchedule::toIcsString(const DSchedule::Ptr &schedule)
     return icalformat.toString(_cal.staticCast<KCalendarCore::Calendar>());
 }
 
+QByteArray DSchedule::toBinary(const DSchedule::Ptr &schedule)
+{
+    QByteArray data;
+    if (schedule.isNull()) {
+        return data;
+    }
+    QDataStream out(&data, QIODevice::WriteOnly);
+    out.setVersion(QDataStream::Qt_5_6);
+    out << BinaryMagic << BinaryVersion;
+    out << schedule.staticCast<KCalendarCore::IncidenceBase>();
+    out << schedule->m_scheduleTypeID << schedule->m_fileName << schedule->m_compatibleID;
+    return data;
+}
+
+bool DSchedule::fromBinary(DSchedule::Ptr &schedule, const QByteArray &data)
+{
+    if (data.isEmpty()) {
+        return false;
+    }
+    QDataStream in(data);
+    in.setVersion(QDataStream::Qt_5_6);
+    quint32 magic = 0;
+    quint32 version = 0;
+    in >> magic >> version;
+    if (magic != BinaryMagic || version != BinaryVersion) {
+        return false;
+    }
+    DSchedule::Ptr binSchedule(new DSchedule);
+    KCalendarCore::IncidenceBase::Ptr incidence = binSchedule;
+    in >> incidence;
+    in >> binSchedule->m_scheduleTypeID >> binSchedule->m_fileName >> binSchedule->m_compatibleID;
+    if (in.status() != QDataStream::Ok) {
+        return false;
+    }
+    schedule = binSchedule;
+    return true;
+}
+
 QMap<QDate, DSchedule::List> DSchedule::fromMapString(const QString &json)
 {
     QMap<QDate, DSchedule::List> scheduleMap;
@@ -391,129 +438,99 @@ QString DSchedule::toListString(const QString &query, const DSchedule::List &sch
     return QString::fromUtf8(jsonDoc.toJson(QJsonDocument::Compact));
 }
 
-void DSchedule::expendRecurrence(DSchedule::Map &scheduleMap, const DSchedule::Ptr &schedule, const QDateTime &dtStart, const QDateTime &dtEnd)
+QPair<QString, DSchedule::List> DSchedule::fromListBinary(const QByteArray &data)
 {
-    QDateTime queryDtStart = dtStart;
-    //如果日程为全天日程，则查询的开始时间设置为0点，因为全天日程的开始和结束时间都是0点
-    if(schedule->allDay()){
-        queryDtStart.setTime(QTime(0,0,0));
+    QPair<QString, DSchedule::List> schedulePair;
+    QDataStream in(data);
+    in.setVersion(QDataStream::Qt_5_6);
+    quint32 magic = 0;
+    quint32 version = 0;
+    quint32 count = 0;
+    in >> magic >> version;
+    if (magic != ListBinaryMagic || version != ListBinaryVersion) {
+        qCWarning(CommonLogger) << "invalid schedule list data";
+        return schedulePair;
     }
-    if (schedule->recurs()) {
-        //获取日程的开始结束时间差
-        qint64 interval = schedule->dtStart().secsTo(schedule->dtEnd());
-        QList<QDateTime> dtList = schedule->recurrence()->timesInInterval(queryDtStart, dtEnd);
-        foreach (auto &dt, dtList) {
-            QDateTime scheduleDtEnd = dt.addSecs(interval);
-            DSchedule::Ptr newSchedule = DSchedule::Ptr(schedule->clone());
-            newSchedule->setDtStart(dt);
-            newSchedule->setDtEnd(scheduleDtEnd);
-
-            //只有重复日程设置RecurrenceId
-            if (schedule->dtStart() != dt) {
-                newSchedule->setRecurrenceId(dt);
-            }
-            scheduleMap[dt.date()].append(newSchedule);
-        }
-    } else {
-        if (!(schedule->dtStart() > dtEnd || schedule->dtEnd() < queryDtStart)) {
-            scheduleMap[schedule->dtStart().date()].append(schedule);
+    in >> schedulePair.first >> count;
+    DSchedule::List scheduleList;
+    for (quint32 i = 0; i < count && in.status() == QDataStream::Ok; ++i) {
+        QByteArray scheduleData;
+        in >> scheduleData;
+        DSchedule::Ptr schedule;
+        if (fromBinary(schedule, scheduleData)) {
+            scheduleList.append(schedule);
         }
     }
+    schedulePair.second = scheduleList;
+    return schedulePair;
 }
 
-QMap<QDate, DSchedule::List> DSchedule::convertSchedules(const DScheduleQueryPar::Ptr &queryPar, const DSchedule::List &scheduleList)
+QByteArray DSchedule::toListBinary(const QString &query, const DSchedule::List &scheduleList)
 {
-    QDateTime dtStart = queryPar->dtStart();
-    QDateTime dtEnd = queryPar->dtEnd();
-    bool extend = queryPar->queryType() == DScheduleQueryPar::Query_None;
-
-    QMap<QDate, DSchedule::List> scheduleMap;
+    QByteArray data;
+    QDataStream out(&data, QIODevice::WriteOnly);
+    out.setVersion(QDataStream::Qt_5_6);
+    out << ListBinaryMagic << ListBinaryVersion << query << static_cast<quint32>(scheduleList.size());
     foreach (auto &schedule, scheduleList) {
-        //获取日程的开始结束时间差
-        qint64 interval = schedule->dtStart().secsTo(schedule->dtEnd());
-        //如果存在重复日程
-        if (schedule->recurs()) {
-            //如果为农历日程
-            if (schedule->lunnar()) {
-                //农历重复日程计算
-                LunarDateInfo lunardate(schedule->recurrence()->defaultRRuleConst(), interval);
-
-                QMap<int, QDate> ruleStartDate = lunardate.getRRuleStartDate(dtStart.date(), dtEnd.date(), schedule->dtStart().date());
-
-                QDateTime recurDateTime;
-                recurDateTime.setTime(schedule->dtStart().time());
-                QDateTime copyEnd;
-                QMap<int, QDate>::ConstIterator iter = ruleStartDate.constBegin();
-                for (; iter != ruleStartDate.constEnd(); iter++) {
-                    recurDateTime.setDate(iter.value());
-                    //如果在忽略时间列表中,则忽略
-                    if (schedule->recurrence()->exDateTimes().contains(recurDateTime))
-                        continue;
-                    copyEnd = recurDateTime.addSecs(interval);
-                    DSchedule::Ptr newSchedule = DSchedule::Ptr(new DSchedule(*schedule.data()));
-                    newSchedule->setDtStart(recurDateTime);
-                    newSchedule->setDtEnd(copyEnd);
-                    //只有重复日程设置RecurrenceId
-                    if (schedule->dtStart() != recurDateTime) {
-                        newSchedule->setRecurrenceId(recurDateTime);
-                    }
-                    scheduleMap[recurDateTime.date()].append(newSchedule);
-                }
-            } else {
-                //非农历日程
-                expendRecurrence(scheduleMap, schedule, dtStart, dtEnd);
-            }
-        } else {
-            //普通日程
-            //如果在查询时间范围内
-            QDateTime queryDtStart = dtStart;
-            //如果日程为全天日程，则查询的开始时间设置为0点，因为全天日程的开始和结束时间都是0点
-            if(schedule->allDay()){
-                queryDtStart.setTime(QTime(0,0,0));
-            }
-            if (!(schedule->dtEnd() < queryDtStart || schedule->dtStart() > dtEnd)) {
-                if (extend && schedule->isMultiDay()) {
-                    //需要扩展的天数
-                    int extenddays = static_cast<int>(schedule->dtStart().daysTo(schedule->dtEnd()));
-                    for (int i = 0; i <= extenddays; ++i) {
-                        //如果扩展的日期在查询范围内则添加，否则退出
-                        if(scheduleMap.contains(schedule->dtStart().date().addDays(i))){
-                            scheduleMap[schedule->dtStart().date().addDays(i)].append(schedule);
-                        } else {
-                            break;
-                        }
-                    }
-                } else {
-                    scheduleMap[schedule->dtStart().date()].append(schedule);
-                }
-            }
-        }
+        out << toBinary(schedule);
     }
+    return data;
+}
 
-    //如果为查询前N个日程，则取前N个日程
-    if (queryPar->queryType() == DScheduleQueryPar::Query_Top) {
-        int scheduleNum = 0;
-        DSchedule::Map filterSchedule;
-        DSchedule::Map::const_iterator iter = scheduleMap.constBegin();
-        for (; iter != scheduleMap.constEnd(); ++iter) {
-            if (iter.value().size() == 0) {
-                continue;
-            }
-            if (scheduleNum + iter.value().size() > queryPar->queryTop()) {
-                DSchedule::List scheduleList;
-                int residuesNum = queryPar->queryTop() - scheduleNum;
-                for (int i = 0; i < residuesNum; ++i) {
-                    scheduleList.append(iter.value().at(i));
-                }
-                filterSchedule[iter.key()] = scheduleList;
-            } else {
-                filterSchedule[iter.key()] = iter.value();
-            }
+DSchedule::List DSchedule::expandOccurrences(const DSchedule::Ptr &schedule, const QDateTime &dtStart, const QDateTime &dtEnd)
+{
+    return DScheduleOccurrence::toScheduleList(DScheduleOccurrence::expand(schedule, dtStart, dtEnd));
+}
+
+namespace {
+//日程数量超过该值时才并行展开，数量较少时线程调度的开销大于展开本身
+const int ParallelExpandThreshold = 64;
+
+//展开单个日程，供QtConcurrent调用
+struct ExpandOccurrencesFunctor {
+    typedef DSchedule::List result_type;
+    QDateTime dtStart;
+    QDateTime dtEnd;
+    DSchedule::List operator()(const DSchedule::Ptr &schedule) const
+    {
+        return DSchedule::expandOccurrences(schedule, dtStart, dtEnd);
+    }
+};
+
+void appendOccurrences(DSchedule::List &result, const DSchedule::List &occurrences)
+{
+    result.append(occurrences);
+}
+} // namespace
+
+DSchedule::List DSchedule::expandOccurrences(const DSchedule::List &scheduleList, const QDateTime &dtStart, const QDateTime &dtEnd)
+{
+    if (scheduleList.size() < ParallelExpandThreshold) {
+        DSchedule::List occurrences;
+        foreach (auto &schedule, scheduleList) {
+            occurrences.append(expandOccurrences(schedule, dtStart, dtEnd));
         }
-        scheduleMap = filterSchedule;
+        return occurrences;
     }
+    //每个日程的展开互不影响，在线程池中并行展开，按日程原有顺序合并结果，保证结果与顺序展开一致
+    ExpandOccurrencesFunctor functor{dtStart, dtEnd};
+    return QtConcurrent::blockingMappedReduced<DSchedule::List>(scheduleList, functor, appendOccurrences,
+                                                                QtConcurrent::OrderedReduce | QtConcurrent::SequentialReduce);
+}
 
-    return scheduleMap;
+QMap<QDate, DSchedule::List> DSchedule::occurrencesToMap(const DScheduleQueryPar::Ptr &queryPar, const DSchedule::List &occurrences)
+{
+    DScheduleOccurrence::List occurrenceList;
+    occurrenceList.reserve(occurrences.size());
+    foreach (auto &schedule, occurrences) {
+        occurrenceList.append(DScheduleOccurrence(schedule));
+    }
+    return DScheduleOccurrence::toScheduleMap(DScheduleOccurrence::toMap(queryPar, occurrenceList));
+}
+
+QMap<QDate, DSchedule::List> DSchedule::convertSchedules(const DScheduleQueryPar::Ptr &queryPar, const DSchedule::List &scheduleList)
+{
+    return occurrencesToMap(queryPar, expandOccurrences(scheduleList, queryPar->dtStart(), queryPar->dtEnd()));
 }
 
 QMap<QDate, DSchedule::List> DSchedule::fromQueryResult(const QString &query)
@@ -529,6 +546,24 @@ QMap<QDate, DSchedule::List> DSchedule::fromQueryResult(const QString &query)
     return scheduleMap;
 }
 
+QMap<QDate, DSchedule::List> DSchedule::fromQueryResult(const QByteArray &data)
+{
+    QMap<QDate, DSchedule::List> scheduleMap;
+    QPair<QString, DSchedule::List> pair = fromListBinary(data);
+    DScheduleQueryPar::Ptr queryPar = DScheduleQueryPar::fromJsonString(pair.first);
+    if (queryPar.isNull()) {
+        return scheduleMap;
+    }
+
+    scheduleMap = DSchedule::convertSchedules(queryPar, pair.second);
+    return scheduleMap;
+}
+
+QMap<QDate, DSchedule::List> DSchedule::fromOccurrenceResult(const QByteArray &data)
+{
+    return DScheduleOccurrence::toScheduleMap(DScheduleOccurrence::fromOccurrenceResult(data));
+}
+
 bool operator==(const DSchedule::Ptr &s1, const DSchedule::Ptr &s2)
 {
     return s1.isNull() || s2.isNull() ? s1.isNull() && s2.isNull() : s1->instanceIdentifier() == s2->instanceIdentifier();
@@ -89,6 +89,10 @@ public:
     static bool fromIcsString(DSchedule::Ptr &schedule, const QString &string);
     static QString toIcsString(const DSchedule::Ptr &schedule);
 
+    //二进制序列化，用于本地缓存日程解析结果，避免重复解析ics
+    static QByteArray toBinary(const DSchedule::Ptr &schedule);
+    static bool fromBinary(DSchedule::Ptr &schedule, const QByteArray &data);
+
     //
     static QMap<QDate, DSchedule::List> fromMapString(const QString &json);
     static QString toMapString(const QMap<QDate, DSchedule::List> &scheduleMap);
@@ -96,9 +100,20 @@ public:
     static QPair<QString, DSchedule::List> fromListString(const QString &json);
     static QString toListString(const QString &query, const DSchedule::List &scheduleList);
 
-    static void expendRecurrence(DSchedule::Map &scheduleMap, const DSchedule::Ptr &schedule, const QDateTime &dtStart, const QDateTime &dtEnd);
+    //日程集二进制格式，每个日程为带长度前缀的toBinary数据，用于dbus传输
+    static QPair<QString, DSchedule::List> fromListBinary(const QByteArray &data);
+    static QByteArray toListBinary(const QString &query, const DSchedule::List &scheduleList);
+
+    //展开日程在时间范围内的所有实例，重复日程每次重复生成一个实例，客户端显示、服务端提醒和查询共用
+    static DSchedule::List expandOccurrences(const DSchedule::Ptr &schedule, const QDateTime &dtStart, const QDateTime &dtEnd);
+    static DSchedule::List expandOccurrences(const DSchedule::List &scheduleList, const QDateTime &dtStart, const QDateTime &dtEnd);
+    //将日程实例按开始日期归类，需要扩展时跨天的普通日程在查询范围内的每一天都显示
+    static QMap<QDate, DSchedule::List> occurrencesToMap(const DScheduleQueryPar::Ptr &queryPar, const DSchedule::List &occurrences);
     static QMap<QDate, DSchedule::List> convertSchedules(const DScheduleQueryPar::Ptr &queryPar, const DSchedule::List &scheduleList);
     static QMap<QDate, DSchedule::List> fromQueryResult(const QString &query);
+    static QMap<QDate, DSchedule::List> fromQueryResult(const QByteArray &data);
+    //解析服务端已展开的日程实例集
+    static QMap<QDate, DSchedule::List> fromOccurrenceResult(const QByteArray &data);
 
 private:
     QMap<int, AlarmType> getAlarmMap();
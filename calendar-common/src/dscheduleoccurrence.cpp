@@ -0,0 +1,314 @@
+// SPDX-FileCopyrightText: 2019 - 2022 UnionTech Software Technology Co., Ltd.
+//
+// SPDX-License-Identifier: LGPL-3.0-or-later
+
+#include "dscheduleoccurrence.h"
+#include "doccurrencecache.h"
+#include "commondef.h"
+#include "lunarandfestival/lunardateinfo.h"
+
+#include <QDataStream>
+#include <QHash>
+
+//实例集二进制数据标识及版本
+static const quint32 OccurrenceBinaryMagic = 0x4453434F;
+static const quint32 OccurrenceBinaryVersion = 1;
+
+DScheduleOccurrence::DScheduleOccurrence()
+{
+}
+
+DScheduleOccurrence::DScheduleOccurrence(const DSchedule::Ptr &schedule)
+    : m_master(schedule)
+    , m_isMaster(true)
+{
+    if (!schedule.isNull()) {
+        m_dtStart = schedule->dtStart();
+        m_dtEnd = schedule->dtEnd();
+        m_recurrenceId = schedule->recurrenceId();
+    }
+}
+
+DScheduleOccurrence::DScheduleOccurrence(const DSchedule::Ptr &master, const QDateTime &dtStart, const QDateTime &dtEnd, const QDateTime &recurrenceId)
+    : m_master(master)
+    , m_dtStart(dtStart)
+    , m_dtEnd(dtEnd)
+    , m_recurrenceId(recurrenceId)
+{
+}
+
+DSchedule::Ptr DScheduleOccurrence::master() const
+{
+    return m_master;
+}
+
+QDateTime DScheduleOccurrence::dtStart() const
+{
+    return m_dtStart;
+}
+
+QDateTime DScheduleOccurrence::dtEnd() const
+{
+    return m_dtEnd;
+}
+
+QDateTime DScheduleOccurrence::recurrenceId() const
+{
+    return m_recurrenceId;
+}
+
+bool DScheduleOccurrence::isNull() const
+{
+    return m_master.isNull();
+}
+
+DSchedule::Ptr DScheduleOccurrence::toSchedule() const
+{
+    if (m_isMaster || m_master.isNull()) {
+        return m_master;
+    }
+    DSchedule::Ptr schedule(m_master->clone());
+    schedule->setDtStart(m_dtStart);
+    schedule->setDtEnd(m_dtEnd);
+    //只有重复日程设置RecurrenceId
+    if (m_recurrenceId.isValid()) {
+        schedule->setRecurrenceId(m_recurrenceId);
+    }
+    return schedule;
+}
+
+DScheduleOccurrence::List DScheduleOccurrence::expand(const DSchedule::Ptr &schedule, const QDateTime &dtStart, const QDateTime &dtEnd)
+{
+    List occurrences;
+    if (schedule.isNull()) {
+        return occurrences;
+    }
+    QDateTime queryDtStart = dtStart;
+    //如果日程为全天日程，则查询的开始时间设置为0点，因为全天日程的开始和结束时间都是0点
+    if (schedule->allDay()) {
+        queryDtStart.setTime(QTime(0, 0, 0));
+    }
+    //获取日程的开始结束时间差
+    qint64 interval = schedule->dtStart().secsTo(schedule->dtEnd());
+    //如果存在重复日程
+    if (schedule->recurs()) {
+        QList<QDateTime> dtList;
+        //重复日程每次都是从ics或二进制数据重新解析的，重复规则自带的缓存无法复用，使用进程内共享的实例时间缓存
+        const QByteArray cacheKey = DOccurrenceCache::cacheKey(*schedule, queryDtStart, dtEnd);
+        if (!DOccurrenceCache::instance()->value(cacheKey, dtList)) {
+            //如果为农历日程
+            if (schedule->lunnar()) {
+                //农历重复日程计算
+                LunarDateInfo lunardate(schedule->recurrence()->defaultRRuleConst(), interval);
+                QMap<int, QDate> ruleStartDate = lunardate.getRRuleStartDate(dtStart.date(), dtEnd.date(), schedule->dtStart().date());
+                QDateTime recurDateTime;
+                recurDateTime.setTime(schedule->dtStart().time());
+                QMap<int, QDate>::ConstIterator iter = ruleStartDate.constBegin();
+                for (; iter != ruleStartDate.constEnd(); iter++) {
+                    recurDateTime.setDate(iter.value());
+                    //如果在忽略时间列表中,则忽略
+                    if (schedule->recurrence()->exDateTimes().contains(recurDateTime))
+                        continue;
+                    dtList.append(recurDateTime);
+                }
+            } else {
+                //非农历日程
+                dtList = schedule->recurrence()->timesInInterval(queryDtStart, dtEnd);
+            }
+            DOccurrenceCache::instance()->insert(cacheKey, dtList);
+        }
+        occurrences.reserve(dtList.size());
+        foreach (auto &dt, dtList) {
+            //只有重复日程设置RecurrenceId
+            occurrences.append(DScheduleOccurrence(schedule, dt, dt.addSecs(interval),
+                                                   schedule->dtStart() != dt ? dt : QDateTime()));
+        }
+    } else {
+        //普通日程
+        //如果在查询时间范围内
+        if (!(schedule->dtEnd() < queryDtStart || schedule->dtStart() > dtEnd)) {
+            occurrences.append(DScheduleOccurrence(schedule));
+        }
+    }
+    return occurrences;
+}
+
+DScheduleOccurrence::List DScheduleOccurrence::expand(const DSchedule::List &scheduleList, const QDateTime &dtStart, const QDateTime &dtEnd)
+{
+    List occurrences;
+    foreach (auto &schedule, scheduleList) {
+        occurrences.append(expand(schedule, dtStart, dtEnd));
+    }
+    return occurrences;
+}
+
+DScheduleOccurrence::Map DScheduleOccurrence::toMap(const DScheduleQueryPar::Ptr &queryPar, const List &occurrences)
+{
+    QDate dateStart = queryPar->dtStart().date();
+    QDate dateEnd = queryPar->dtEnd().date();
+    bool extend = queryPar->queryType() == DScheduleQueryPar::Query_None;
+
+    Map occurrenceMap;
+    foreach (auto &occurrence, occurrences) {
+        if (occurrence.isNull()) {
+            continue;
+        }
+        //跨天的普通日程需要在查询范围内的每一天显示，重复日程只在开始日期显示
+        if (extend && !occurrence.m_master->recurs() && occurrence.m_master->isMultiDay()) {
+            //需要扩展的天数
+            int extenddays = static_cast<int>(occurrence.dtStart().daysTo(occurrence.dtEnd()));
+            for (int i = 0; i <= extenddays; ++i) {
+                QDate date = occurrence.dtStart().date().addDays(i);
+                //如果扩展的日期在查询范围内则添加
+                if (date >= dateStart && date <= dateEnd) {
+                    occurrenceMap[date].append(occurrence);
+                }
+            }
+        } else {
+            occurrenceMap[occurrence.dtStart().date()].append(occurrence);
+        }
+    }
+
+    //如果为查询前N个日程，则取前N个日程
+    if (queryPar->queryType() == DScheduleQueryPar::Query_Top) {
+        int scheduleNum = 0;
+        Map filterOccurrence;
+        Map::const_iterator iter = occurrenceMap.constBegin();
+        for (; iter != occurrenceMap.constEnd(); ++iter) {
+            if (iter.value().size() == 0) {
+                continue;
+            }
+            if (scheduleNum + iter.value().size() > queryPar->queryTop()) {
+                List occurrenceList;
+                int residuesNum = queryPar->queryTop() - scheduleNum;
+                for (int i = 0; i < residuesNum; ++i) {
+                    occurrenceList.append(iter.value().at(i));
+                }
+                filterOccurrence[iter.key()] = occurrenceList;
+            } else {
+                filterOccurrence[iter.key()] = iter.value();
+            }
+        }
+        occurrenceMap = filterOccurrence;
+    }
+
+    return occurrenceMap;
+}
+
+DSchedule::List DScheduleOccurrence::toScheduleList(const List &occurrences)
+{
+    DSchedule::List scheduleList;
+    scheduleList.reserve(occurrences.size());
+    foreach (auto &occurrence, occurrences) {
+        if (!occurrence.isNull()) {
+            scheduleList.append(occurrence.toSchedule());
+        }
+    }
+    return scheduleList;
+}
+
+DSchedule::Map DScheduleOccurrence::toScheduleMap(const Map &occurrenceMap)
+{
+    DSchedule::Map scheduleMap;
+    //跨天显示的只有普通日程，各天共用原日程，重复日程的实例只在开始日期出现一次
+    for (auto iter = occurrenceMap.constBegin(); iter != occurrenceMap.constEnd(); ++iter) {
+        scheduleMap.insert(iter.key(), toScheduleList(iter.value()));
+    }
+    return scheduleMap;
+}
+
+QByteArray DScheduleOccurrence::toListBinary(const QString &query, const List &occurrences)
+{
+    //原日程按指针去重，每个原日程只保存一次
+    QHash<const DSchedule *, quint32> masterIndex;
+    DSchedule::List masterList;
+    quint32 count = 0;
+    foreach (auto &occurrence, occurrences) {
+        if (occurrence.isNull()) {
+            continue;
+        }
+        ++count;
+        if (!masterIndex.contains(occurrence.m_master.data())) {
+            masterIndex.insert(occurrence.m_master.data(), static_cast<quint32>(masterList.size()));
+            masterList.append(occurrence.m_master);
+        }
+    }
+
+    QByteArray data;
+    QDataStream out(&data, QIODevice::WriteOnly);
+    out.setVersion(QDataStream::Qt_5_6);
+    out << OccurrenceBinaryMagic << OccurrenceBinaryVersion << query << static_cast<quint32>(masterList.size());
+    foreach (auto &schedule, masterList) {
+        out << DSchedule::toBinary(schedule);
+    }
+    out << count;
+    foreach (auto &occurrence, occurrences) {
+        if (occurrence.isNull()) {
+            continue;
+        }
+        out << masterIndex.value(occurrence.m_master.data()) << occurrence.m_isMaster;
+        //日程本身作为实例时时间与原日程一致，不需要保存
+        if (!occurrence.m_isMaster) {
+            out << occurrence.m_dtStart << occurrence.m_dtEnd << occurrence.m_recurrenceId;
+        }
+    }
+    return data;
+}
+
+QPair<QString, DScheduleOccurrence::List> DScheduleOccurrence::fromListBinary(const QByteArray &data)
+{
+    QPair<QString, List> occurrencePair;
+    QDataStream in(data);
+    in.setVersion(QDataStream::Qt_5_6);
+    quint32 magic = 0;
+    quint32 version = 0;
+    quint32 count = 0;
+    in >> magic >> version;
+    if (magic != OccurrenceBinaryMagic || version != OccurrenceBinaryVersion) {
+        qCWarning(CommonLogger) << "invalid schedule occurrence data";
+        return occurrencePair;
+    }
+    in >> occurrencePair.first >> count;
+    //解析失败的原日程为空，对应的实例会被忽略
+    DSchedule::List masterList;
+    for (quint32 i = 0; i < count && in.status() == QDataStream::Ok; ++i) {
+        QByteArray scheduleData;
+        in >> scheduleData;
+        DSchedule::Ptr schedule;
+        DSchedule::fromBinary(schedule, scheduleData);
+        masterList.append(schedule);
+    }
+    in >> count;
+    List occurrences;
+    for (quint32 i = 0; i < count && in.status() == QDataStream::Ok; ++i) {
+        quint32 index = 0;
+        bool isMaster = false;
+        in >> index >> isMaster;
+        DScheduleOccurrence occurrence;
+        if (isMaster) {
+            occurrence = DScheduleOccurrence(masterList.value(static_cast<int>(index)));
+        } else {
+            QDateTime dtStart;
+            QDateTime dtEnd;
+            QDateTime recurrenceId;
+            in >> dtStart >> dtEnd >> recurrenceId;
+            occurrence = DScheduleOccurrence(masterList.value(static_cast<int>(index)), dtStart, dtEnd, recurrenceId);
+        }
+        if (in.status() == QDataStream::Ok && !occurrence.isNull()) {
+            occurrences.append(occurrence);
+        }
+    }
+    occurrencePair.second = occurrences;
+    return occurrencePair;
+}
+
+DScheduleOccurrence::Map DScheduleOccurrence::fromOccurrenceResult(const QByteArray &data)
+{
+    QPair<QString, List> pair = fromListBinary(data);
+    DScheduleQueryPar::Ptr queryPar = DScheduleQueryPar::fromJsonString(pair.first);
+    if (queryPar.isNull()) {
+        return Map();
+    }
+    //服务端已展开重复日程，只需要按日期归类
+    return toMap(queryPar, pair.second);
+}
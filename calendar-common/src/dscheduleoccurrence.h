@@ -0,0 +1,64 @@
+// SPDX-FileCopyrightText: 2019 - 2022 UnionTech Software Technology Co., Ltd.
+//
+// SPDX-License-Identifier: LGPL-3.0-or-later
+
+#ifndef DSCHEDULEOCCURRENCE_H
+#define DSCHEDULEOCCURRENCE_H
+
+#include "dschedule.h"
+#include "dschedulequerypar.h"
+
+#include <QDateTime>
+#include <QVector>
+#include <QMap>
+
+//日程实例
+//重复日程的每次重复只保存原日程和本次重复的时间，多个实例共用原日程的数据，需要完整日程时再生成
+class DScheduleOccurrence
+{
+public:
+    typedef QVector<DScheduleOccurrence> List;
+    typedef QMap<QDate, List> Map;
+
+    DScheduleOccurrence();
+    //日程本身作为一个实例，如非重复日程或已经生成的实例
+    explicit DScheduleOccurrence(const DSchedule::Ptr &schedule);
+    //重复日程的一次重复
+    DScheduleOccurrence(const DSchedule::Ptr &master, const QDateTime &dtStart, const QDateTime &dtEnd, const QDateTime &recurrenceId);
+
+    DSchedule::Ptr master() const;
+    QDateTime dtStart() const;
+    QDateTime dtEnd() const;
+    QDateTime recurrenceId() const;
+    bool isNull() const;
+
+    /**
+     * @brief toSchedule    生成实例对应的完整日程
+     * @return              日程本身作为实例时返回原日程，否则复制原日程并设置本次重复的时间
+     */
+    DSchedule::Ptr toSchedule() const;
+
+    //展开日程在时间范围内的所有实例
+    static List expand(const DSchedule::Ptr &schedule, const QDateTime &dtStart, const QDateTime &dtEnd);
+    static List expand(const DSchedule::List &scheduleList, const QDateTime &dtStart, const QDateTime &dtEnd);
+    //将实例按开始日期归类，需要扩展时跨天的普通日程在查询范围内的每一天都显示
+    static Map toMap(const DScheduleQueryPar::Ptr &queryPar, const List &occurrences);
+
+    static DSchedule::List toScheduleList(const List &occurrences);
+    static DSchedule::Map toScheduleMap(const Map &occurrenceMap);
+
+    //实例集二进制格式，原日程只保存一次，每个实例只保存时间，用于dbus传输
+    static QByteArray toListBinary(const QString &query, const List &occurrences);
+    static QPair<QString, List> fromListBinary(const QByteArray &data);
+    //解析服务端已展开的日程实例集
+    static Map fromOccurrenceResult(const QByteArray &data);
+
+private:
+    DSchedule::Ptr m_master;
+    QDateTime m_dtStart;
+    QDateTime m_dtEnd;
+    QDateTime m_recurrenceId;
+    bool m_isMaster = false; //实例是否为原日程本身
+};
+
+#endif // DSCHEDULEOCCURRENCE_H
@@ -97,8 +97,14 @@ void CaHuangLiDayInfo::registerMetaType()
 QString CaHuangLiDayInfo::toJson()
 {
     QJsonDocument doc;
-    QJsonObject obj;
+    doc.setObject(toJsonObject());
+    QString strJson = QString::fromUtf8(doc.toJson(QJsonDocument::Compact));
+    return strJson;
+}
 
+QJsonObject CaHuangLiDayInfo::toJsonObject() const
+{
+    QJsonObject obj;
     obj.insert("Suit", mSuit);
     obj.insert("Avoid", mAvoid);
     obj.insert("Worktime", mWorktime);
@@ -112,10 +118,7 @@ QString CaHuangLiDayInfo::toJson()
     obj.insert("GanZhiDay", mGanZhiDay);
     obj.insert("GanZhiMonth", mGanZhiMonth);
     obj.insert("GanZhiYear", mGanZhiYear);
-
-    doc.setObject(obj);
-    QString strJson = QString::fromUtf8(doc.toJson(QJsonDocument::Compact));
-    return strJson;
+    return obj;
 }
 
 void CaHuangLiDayInfo::strJsonToInfo(const QString &strJson, bool &isVaild)
@@ -228,22 +231,8 @@ QString CaHuangLiMonthInfo::toJson()
     QJsonObject obj;
     obj.insert("Days", mDays);
     obj.insert("FirstDayWeek", mFirstDayWeek);
-    foreach (CaHuangLiDayInfo dayinfo, mCaLunarDayInfo) {
-        QJsonObject dayobj;
-        dayobj.insert("Suit", dayinfo.mSuit);
-        dayobj.insert("Avoid", dayinfo.mAvoid);
-        dayobj.insert("Worktime", dayinfo.mWorktime);
-        dayobj.insert("LunarFestival", dayinfo.mLunarFestival);
-        dayobj.insert("SolarFestival", dayinfo.mSolarFestival);
-        dayobj.insert("Term", dayinfo.mTerm);
-        dayobj.insert("Zodiac", dayinfo.mZodiac);
-        dayobj.insert("LunarLeapMonth", dayinfo.mLunarLeapMonth);
-        dayobj.insert("LunarDayName", dayinfo.mLunarDayName);
-        dayobj.insert("LunarMonthName", dayinfo.mLunarMonthName);
-        dayobj.insert("GanZhiDay", dayinfo.mGanZhiDay);
-        dayobj.insert("GanZhiMonth", dayinfo.mGanZhiMonth);
-        dayobj.insert("GanZhiYear", dayinfo.mGanZhiYear);
-        daysarr.append(dayobj);
+    foreach (const CaHuangLiDayInfo &dayinfo, mCaLunarDayInfo) {
+        daysarr.append(dayinfo.toJsonObject());
     }
     obj.insert("Datas", daysarr);
     doc.setObject(obj);
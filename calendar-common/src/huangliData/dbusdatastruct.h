@@ -91,6 +91,7 @@ public:
     friend QDBusArgument &operator<<(QDBusArgument &argument, const CaHuangLiDayInfo &what);
     friend const QDBusArgument &operator>>(const QDBusArgument &argument, CaHuangLiDayInfo &what);
     QString toJson();
+    QJsonObject toJsonObject() const;
     void strJsonToInfo(const QString &strJson, bool &isVaild);
     void jsonObjectToInfo(const QJsonObject &jsonObject);
 public:
@@ -189,6 +189,31 @@ static QVector<NuationCoefficient> nuation {
 // Gregorian历TT2000年1月1日中午12点的儒略日
 const double J2000 = 2451545.0;
 
+// VSOP87周期项，结构数组形式，第i项为 A[i] * cos(B[i] + C[i] * t)
+struct VsopSeries {
+    const double *A; // 振幅
+    const double *B; // 相位
+    const double *C; // 频率
+    int size;
+};
+
+// 地球日心黄经L0~L5、黄纬B0~B4、日地距离R0~R5周期项
+extern const VsopSeries EarthLSeries[6];
+extern const VsopSeries EarthBSeries[5];
+extern const VsopSeries EarthRSeries[6];
+
+// 计算单个时间的周期项之和
+double EvaluateVsopSeries(const VsopSeries &series, double t);
+
+/**
+ * @brief EvaluateVsopSeries    批量计算多个时间的周期项之和，结果与逐个计算完全一致
+ * @param series                周期项
+ * @param t                     儒略千年数
+ * @param result                计算结果，长度与t相同
+ * @param count                 时间个数
+ */
+void EvaluateVsopSeries(const VsopSeries &series, const double *t, double *result, int count);
+
 double GetEarthL0(double t);
 
 double GetEarthL1(double t);
@@ -9,9 +9,11 @@
 #include <QDate>
 
 QMap<int, LunarCalendar *> LunarCalendar::glYearCache;
+QMutex LunarCalendar::glYearCacheMutex;
 
 LunarCalendar *LunarCalendar::GetLunarCalendar(qint32 year)
 {
+    QMutexLocker locker(&glYearCacheMutex);
     auto it = glYearCache.find(year);
     LunarCalendar *plcal = nullptr;
     if (it != glYearCache.end()) {
@@ -28,6 +30,7 @@ LunarCalendar *LunarCalendar::GetLunarCalendar(qint32 year)
  */
 void LunarCalendar::LogOffEmptyData()
 {
+    QMutexLocker locker(&glYearCacheMutex);
     QMap<int, LunarCalendar *>::iterator it = glYearCache.begin();
     for (; it != glYearCache.end(); ++it) {
         delete it.value();
@@ -72,6 +75,41 @@ lunarInfo LunarCalendar::SolarDayToLunarDay(qint32 month, qint32 day)
     return dayinfo;
 }
 
+bool LunarCalendar::toYearData(LunarYearData &data) const
+{
+    if (Months.size() != 14) {
+        return false;
+    }
+    const qint64 firstShuoDay = QDate(Year, 1, 1).daysTo(Months.first().ShuoTime.date());
+    if (firstShuoDay < -366 || firstShuoDay > 0) {
+        return false;
+    }
+    data.firstShuoDay = static_cast<qint16>(firstShuoDay);
+    data.bigMonthBits = 0;
+    data.leapMonth = 0;
+    for (int i = 0; i < Months.size(); ++i) {
+        const lunarInfo &lm = Months.at(i);
+        if (lm.LunarMonthDays != 29 && lm.LunarMonthDays != 30) {
+            return false;
+        }
+        if (lm.LunarMonthDays == 30) {
+            data.bigMonthBits |= static_cast<quint16>(1 << i);
+        }
+        if (lm.IsLeap) {
+            data.leapMonth = static_cast<quint8>(i);
+        }
+    }
+    // SolarTermJDs的第一个节气为上一年的冬至，数据表只保存当年的24个节气
+    for (int i = 0; i < 24; ++i) {
+        const QDate termDate = SolarTermTimes.at(i + 1).date();
+        if (termDate.year() != Year) {
+            return false;
+        }
+        data.solarTermYearDays[i] = static_cast<quint16>(termDate.dayOfYear());
+    }
+    return true;
+}
+
 LunarCalendar::LunarCalendar(qint32 year)
 {
     Year = year;
@@ -6,17 +6,25 @@
 #define LUNARCALENDAR_H
 #include "lunarandfestival.h"
 #include "method_interface.h"
+#include "lunaryeartable.h"
 
 #include <QObject>
 #include <QMap>
+#include <QMutex>
 
 class LunarCalendar
 {
 public:
+    //获取天文算法计算的农历年，计算结果会被缓存，可以在多线程中调用
     static LunarCalendar *GetLunarCalendar(qint32 year);
     //程序退出时情况数据
     static void LogOffEmptyData();
     lunarInfo SolarDayToLunarDay(qint32 month, qint32 day);
+    /**
+     * @brief toYearData    转换为农历年数据表的数据
+     * @return              农历月天数或节气不在数据表可表示的范围内时返回false
+     */
+    bool toYearData(LunarYearData &data) const;
 
 private:
     explicit LunarCalendar(qint32 year);
@@ -28,6 +36,7 @@ private:
 public:
 private:
     static QMap<int, LunarCalendar *> glYearCache;
+    static QMutex glYearCacheMutex;
     int Year; // 公历年份
     QVector<double> SolarTermJDs; // 相关的 25 节气 北京时间 儒略日
     QVector<QDateTime> SolarTermTimes; // 对应 SolarTermJDs 转换为 time.Time 的时间
@@ -4,7 +4,7 @@
 
 #include "lunardateinfo.h"
 
-#include "lunarcalendar.h"
+#include "lunaryeartable.h"
 
 #include <QDebug>
 
@@ -58,8 +58,7 @@ QMap<int, QDate> LunarDateInfo::getAllNextMonthLunarDayBySolar(const QDate &sola
     QMap<int, QDate> solar;
     //如果需要通过公历信息获取下一个对应农历信息对应的天
 
-    LunarCalendar *lunc = LunarCalendar::GetLunarCalendar(solarDate.year());
-    lunarInfo info = lunc->SolarDayToLunarDay(solarDate.month(), solarDate.day());
+    lunarInfo info = LunarYearTable::SolarDayToLunarDay(solarDate.year(), solarDate.month(), solarDate.day());
     //计算时间为日程开始时间
     QDate nextSolar = solarDate;
     int count = 0;
@@ -80,8 +79,7 @@ QMap<int, QDate> LunarDateInfo::getAllNextYearLunarDayBySolar(const QDate &solar
 
     //TODO: 需要优化
     //日程的农历日期
-    LunarCalendar *solarDateLunar = LunarCalendar::GetLunarCalendar(solarDate.year());
-    lunarInfo info = solarDateLunar->SolarDayToLunarDay(solarDate.month(), solarDate.day());
+    lunarInfo info = LunarYearTable::SolarDayToLunarDay(solarDate.year(), solarDate.month(), solarDate.day());
     //计算时间为日程开始时间
     QDate bDate = solarDate;
     QDate beforeDate;
@@ -92,8 +90,7 @@ QMap<int, QDate> LunarDateInfo::getAllNextYearLunarDayBySolar(const QDate &solar
     while (bDate <= m_queryEndDate && beforeDate != bDate) {
         beforeDate = bDate;
         //开始时间农历日期
-        LunarCalendar *lunc = LunarCalendar::GetLunarCalendar(bDate.year());
-        lunarInfo startLunarInfo = lunc->SolarDayToLunarDay(bDate.month(), bDate.day());
+        lunarInfo startLunarInfo = LunarYearTable::SolarDayToLunarDay(bDate.year(), bDate.month(), bDate.day());
         //判断起始时间的农历月份是否大于日程的月份，如果大于则说明起始时间的农历年份没有对应的重复日程，直接计算下一个农历年份
         if (startLunarInfo.LunarMonthName > info.LunarMonthName) {
             //更新起始时间
@@ -165,8 +162,7 @@ QMap<int, QDate> LunarDateInfo::getAllNextYearLunarDayBySolar(const QDate &solar
 
 lunarInfo LunarDateInfo::getNextMonthLunarDay(QDate &nextDate, const lunarInfo &info)
 {
-    LunarCalendar *lunc = LunarCalendar::GetLunarCalendar(nextDate.year());
-    lunarInfo nextinfo = lunc->SolarDayToLunarDay(nextDate.month(), nextDate.day());
+    lunarInfo nextinfo = LunarYearTable::SolarDayToLunarDay(nextDate.year(), nextDate.month(), nextDate.day());
     //判断农历的天是否为重复的天，比如一月初一，加上一月份的天数应该为二月初一
     //如果不一样，则说明这个月没有这一天，比如正月三十，加上正月的月份天数，到了二月份是没有三十的，
     if (nextinfo.LunarDay != info.LunarDay) {
@@ -4,6 +4,7 @@
 
 #include "lunarmanager.h"
 #include "lunarcalendar.h"
+#include "lunaryeartable.h"
 #include "commondef.h"
 #include "pinyin/pinyinsearch.h"
 
@@ -12,8 +13,7 @@
 stLunarDayInfo SolarToLunar(qint32 year, qint32 month, qint32 day)
 {
     stLunarDayInfo info;
-    LunarCalendar *pcalendar = LunarCalendar::GetLunarCalendar(year);
-    lunarInfo lday = pcalendar->SolarDayToLunarDay(month, day);
+    lunarInfo lday = LunarYearTable::SolarDayToLunarDay(year, month, day);
     info.GanZhiYear = GetGanZhiYear(lday.LunarYear);
     info.GanZhiMonth = GetGanZhiMonth(year, lday.MonthZhi);
     info.GanZhiDay = GetGanZhiDay(year, month, day);
@@ -150,8 +150,7 @@ QList<stDayFestival> GetFestivalsInRange(const QDateTime &start, const QDateTime
             int year = tem.date().year();
             int month = tem.date().month();
             int day = tem.date().day();
-            LunarCalendar *pcalendar = LunarCalendar::GetLunarCalendar(year);
-            lunarInfo lday = pcalendar->SolarDayToLunarDay(month, day);
+            lunarInfo lday = LunarYearTable::SolarDayToLunarDay(year, month, day);
             QString festival = GetSolarDayFestival(year, month, day);
             QStringList strfestivallist = festival.split(",");
             strfestivallist << GetLunarDayFestival(lday.LunarMonthName, lday.LunarDay, lday.LunarMonthDays, lday.SolarTerm);
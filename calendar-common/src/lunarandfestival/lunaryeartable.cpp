@@ -0,0 +1,82 @@
+// SPDX-FileCopyrightText: 2019 - 2022 UnionTech Software Technology Co., Ltd.
+//
+// SPDX-License-Identifier: LGPL-3.0-or-later
+
+#include "lunaryeartable.h"
+#include "lunarcalendar.h"
+
+#include <QDate>
+
+//编译时由lunaryeartablegen生成，定义LunarTableStartYear、LunarTableEndYear和LunarTableData
+#include "lunaryeartable.inc"
+
+qint32 LunarYearTable::startYear()
+{
+    return LunarTableStartYear;
+}
+
+qint32 LunarYearTable::endYear()
+{
+    return LunarTableEndYear;
+}
+
+const LunarYearData *LunarYearTable::yearData(qint32 year)
+{
+    if (year < LunarTableStartYear || year > LunarTableEndYear) {
+        return nullptr;
+    }
+    return &LunarTableData[year - LunarTableStartYear];
+}
+
+lunarInfo LunarYearTable::SolarDayToLunarDay(qint32 year, qint32 month, qint32 day)
+{
+    const LunarYearData *data = yearData(year);
+    if (data == nullptr) {
+        return LunarCalendar::GetLunarCalendar(year)->SolarDayToLunarDay(month, day);
+    }
+    return lunarDayFromData(*data, year, month, day);
+}
+
+lunarInfo LunarYearTable::lunarDayFromData(const LunarYearData &data, qint32 year, qint32 month, qint32 day)
+{
+    lunarInfo dayinfo;
+    const QDate firstDay(year, 1, 1);
+    const int yd = QDate(year, month, day).dayOfYear();
+
+    // 求月地支，十二节为小寒、立春...大雪，即偶数下标的节气
+    int monthZhi = 0;
+    while (monthZhi < 12 && yd >= data.solarTermYearDays[2 * monthZhi]) {
+        monthZhi++;
+    }
+    dayinfo.MonthZhi = monthZhi;
+
+    // 求农历年、月、日，采用夏历建寅，冬至所在月份为农历11月(冬月)
+    int dd = yd - data.firstShuoDay;
+    for (int i = 0; i < 14; ++i) {
+        const int monthDays = (data.bigMonthBits >> i) & 1 ? 30 : 29;
+        if (1 <= dd && dd <= monthDays) {
+            const int yuejian = 11 + i;
+            dayinfo.LunarYear = yuejian <= 12 ? year - 1 : year;
+            dayinfo.LunarMonthName = yuejian <= 12 ? yuejian : yuejian - 12;
+            if (data.leapMonth > 0 && i >= data.leapMonth) {
+                // 闰月及之后的农历月月名减一
+                dayinfo.LunarMonthName--;
+            }
+            dayinfo.LunarMonthDays = monthDays;
+            dayinfo.IsLeap = (data.leapMonth > 0 && i == data.leapMonth);
+            dayinfo.LunarDay = dd;
+            break;
+        }
+        dd -= monthDays;
+    }
+
+    // 求二十四节气，公历每月有两个节气，与天文算法相同只比较日
+    const int index = 2 * month - 1;
+    dayinfo.SolarTerm = -1;
+    if (firstDay.addDays(data.solarTermYearDays[index - 1] - 1).day() == day) {
+        dayinfo.SolarTerm = (index + DongZhi) % 24;
+    } else if (firstDay.addDays(data.solarTermYearDays[index] - 1).day() == day) {
+        dayinfo.SolarTerm = (index + 1 + DongZhi) % 24;
+    }
+    return dayinfo;
+}
@@ -0,0 +1,51 @@
+// SPDX-FileCopyrightText: 2019 - 2022 UnionTech Software Technology Co., Ltd.
+//
+// SPDX-License-Identifier: LGPL-3.0-or-later
+
+#ifndef LUNARYEARTABLE_H
+#define LUNARYEARTABLE_H
+
+#include "lunarandfestival.h"
+
+#include <QtGlobal>
+
+//农历年数据，由天文算法计算得出
+//以公历年为单位，包含从上一年冬至所在农历月开始的14个农历月和当年的24个节气
+struct LunarYearData {
+    qint16 firstShuoDay; // 第一个农历月初一相对当年1月1日的天数
+    quint16 bigMonthBits; // 14个农历月是否为大月（30天），第i位对应第i个农历月
+    quint8 leapMonth; // 闰月在14个农历月中的序号，0表示没有闰月
+    quint16 solarTermYearDays[24]; // 小寒到冬至24个节气在当年的第几天
+};
+
+/**
+ * @brief The LunarYearTable class
+ * 预先计算的农历年数据表，编译时生成，范围内的年份直接查表，范围外的年份使用天文算法计算
+ * 数据表为只读数据，查询不需要加锁
+ */
+class LunarYearTable
+{
+public:
+    //数据表的公历年份范围
+    static qint32 startYear();
+    static qint32 endYear();
+
+    /**
+     * @brief yearData      获取公历年对应的农历年数据
+     * @return              不在数据表范围内时返回nullptr
+     */
+    static const LunarYearData *yearData(qint32 year);
+
+    /**
+     * @brief SolarDayToLunarDay    公历日期转换为农历日
+     * 数据表范围内查表获取，范围外使用LunarCalendar计算，查表结果不包含朔日时刻(ShuoJD、ShuoTime)
+     */
+    static lunarInfo SolarDayToLunarDay(qint32 year, qint32 month, qint32 day);
+
+    /**
+     * @brief lunarDayFromData      根据农历年数据将公历日期转换为农历日
+     */
+    static lunarInfo lunarDayFromData(const LunarYearData &data, qint32 year, qint32 month, qint32 day);
+};
+
+#endif // LUNARYEARTABLE_H
@@ -146,24 +146,55 @@ QVector<double> get25SolarTermJDs(int year, int start)
 
 double GetEarthEclipticLongitudeForSun(double jd)
 {
-    // 计算地球的日心黄经
-    double l = GetSunEclipticLongitudeForEarth(jd);
-    // 计算地球的日心黄纬
-    double b = GetSunEclipticLatitudeForEarth(jd);
-    // 修正章动
-    l += CalcEarthLongitudeNutation(GetJulianCentury(jd));
-    // 转换到fk5
-    l += Vsop2Fk5LongitudeCorrection(l, b, jd);
-    // 转换成太阳的地心黄经
-    l = Mod2Pi(l + M_PI);
-    // 计算光行差
-    // 计算日地距离
-    double r = GetSunRadiusForEarth(jd);
-    // 太阳到地球的光行差参数
-    l -= SecondsToRadians(20.4898) / r;
+    double l = 0.0;
+    GetEarthEclipticLongitudeForSun(&jd, &l, 1);
     return l;
 }
 
+void GetEarthEclipticLongitudeForSun(const double *jd, double *result, int count)
+{
+    // 每批最多同时计算的儒略日个数
+    const int BatchSize = 4;
+    for (int start = 0; start < count; start += BatchSize) {
+        const int n = qMin(BatchSize, count - start);
+        double t[BatchSize];
+        for (int k = 0; k < n; ++k) {
+            t[k] = GetJulianThousandYears(jd[start + k]);
+        }
+        // 同一周期项依次计算多个时间，周期项系数只需读取一次
+        double L[6][BatchSize];
+        double B[5][BatchSize];
+        double R[6][BatchSize];
+        for (int i = 0; i < 6; ++i) {
+            EvaluateVsopSeries(EarthLSeries[i], t, L[i], n);
+            EvaluateVsopSeries(EarthRSeries[i], t, R[i], n);
+        }
+        for (int i = 0; i < 5; ++i) {
+            EvaluateVsopSeries(EarthBSeries[i], t, B[i], n);
+        }
+        for (int k = 0; k < n; ++k) {
+            const double tk = t[k];
+            const double x = jd[start + k];
+            // 计算地球的日心黄经
+            double l = Mod2Pi(((((L[5][k] * tk + L[4][k]) * tk + L[3][k]) * tk + L[2][k]) * tk + L[1][k]) * tk + L[0][k]);
+            // 计算地球的日心黄纬
+            double b = ((((B[4][k] * tk) + B[3][k]) * tk + B[2][k]) * tk + B[1][k]) * tk + B[0][k];
+            // 修正章动
+            l += CalcEarthLongitudeNutation(GetJulianCentury(x));
+            // 转换到fk5
+            l += Vsop2Fk5LongitudeCorrection(l, b, x);
+            // 转换成太阳的地心黄经
+            l = Mod2Pi(l + M_PI);
+            // 计算光行差
+            // 计算日地距离
+            double r = ((((R[5][k] * tk + R[4][k]) * tk + R[3][k]) * tk + R[2][k]) * tk + R[1][k]) * tk + R[0][k];
+            // 太阳到地球的光行差参数
+            l -= SecondsToRadians(20.4898) / r;
+            result[start + k] = l;
+        }
+    }
+}
+
 /**
  * 按儒略日计算地球的日心黄经
  *
@@ -252,33 +283,22 @@ double NewtonIteration(double angle, double x0, bool IsGetSolarTermJD)
     const double Epsilon = 1e-7;
     const double Delta = 5e-6;
     double x;
-    auto func = [angle](double x) -> double {
-        return ModPi(GetEarthEclipticLongitudeForSun(x) - angle);
-    };
-
-    auto func1 = [](double x) -> double {
-        double earth = GetEarthEclipticLongitudeForSun(x);
-        double moon = GetMoonEclipticLongitudeEC(x);
-        double res = ModPi(earth - moon);
-        return res;
-        // return ModPi(GetEarthEclipticLongitudeForSun(x) - GetMoonEclipticLongitudeEC(x));
-    };
 
     while (1) {
         x = x0;
         double fx, fpx;
+        // 函数值和导数需要x、x+Delta、x-Delta三个时间的太阳地心视黄经，批量计算
+        const double jds[3] = {x, x + Delta, x - Delta};
+        double earth[3];
+        GetEarthEclipticLongitudeForSun(jds, earth, 3);
         if (IsGetSolarTermJD) {
-            fx = func(x);
+            fx = ModPi(earth[0] - angle);
             // 导数
-            fpx = (func(x + Delta) - func(x - Delta)) / Delta / 2;
+            fpx = (ModPi(earth[1] - angle) - ModPi(earth[2] - angle)) / Delta / 2;
         } else {
-            //            fx = ModPi(GetEarthEclipticLongitudeForSun(x) - GetMoonEclipticLongitudeEC(x));
-            //            // 导数
-            //            fpx = (ModPi(GetEarthEclipticLongitudeForSun(x + Delta) - GetMoonEclipticLongitudeEC(x))
-            //                   - GetEarthEclipticLongitudeForSun(x - Delta) - GetMoonEclipticLongitudeEC(x)) / Delta / 2;
-            fx = func1(x);
+            fx = ModPi(earth[0] - GetMoonEclipticLongitudeEC(jds[0]));
             // 导数
-            fpx = (func1(x + Delta) - func1(x - Delta)) / Delta / 2;
+            fpx = (ModPi(earth[1] - GetMoonEclipticLongitudeEC(jds[1])) - ModPi(earth[2] - GetMoonEclipticLongitudeEC(jds[2]))) / Delta / 2;
         }
         x0 = x - fx / fpx;
         if (qAbs(x0 - x) <= Epsilon) {
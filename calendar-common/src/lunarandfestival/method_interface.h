@@ -73,6 +73,8 @@ double ToJulianDateHMS(int year, int month, int day, int hour, int minute, doubl
 // 算法摘自 http://en.wikipedia.org/wiki/Julian_day
 int ToJulianDate(int year, int month, int day);
 double GetEarthEclipticLongitudeForSun(double jd);
+// 批量计算多个儒略日的太阳地心视黄经，结果与逐个计算完全一致
+void GetEarthEclipticLongitudeForSun(const double *jd, double *result, int count);
 double GetSunEclipticLongitudeForEarth(double jd);
 //计算儒略千年数
 double GetJulianThousandYears(double jd);
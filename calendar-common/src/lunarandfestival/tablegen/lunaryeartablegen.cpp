@@ -0,0 +1,66 @@
+// SPDX-FileCopyrightText: 2019 - 2022 UnionTech Software Technology Co., Ltd.
+//
+// SPDX-License-Identifier: LGPL-3.0-or-later
+
+//编译时生成农历年数据表
+//用法：lunaryeartablegen <起始公历年> <结束公历年> <输出文件>
+
+#include "lunarcalendar.h"
+
+#include <QFile>
+#include <QTextStream>
+#include <QStringList>
+
+#include <cstdio>
+
+int main(int argc, char *argv[])
+{
+    if (argc != 4) {
+        fprintf(stderr, "usage: %s <start year> <end year> <output file>\n", argv[0]);
+        return 1;
+    }
+    bool startOk = false;
+    bool endOk = false;
+    const int startYear = QString(argv[1]).toInt(&startOk);
+    const int endYear = QString(argv[2]).toInt(&endOk);
+    if (!startOk || !endOk || startYear > endYear) {
+        fprintf(stderr, "invalid year range: %s - %s\n", argv[1], argv[2]);
+        return 1;
+    }
+
+    QString content;
+    QTextStream stream(&content);
+    stream << "// generated by lunaryeartablegen, do not edit\n";
+    stream << "static const qint32 LunarTableStartYear = " << startYear << ";\n";
+    stream << "static const qint32 LunarTableEndYear = " << endYear << ";\n";
+    stream << "static const LunarYearData LunarTableData[] = {\n";
+    for (int year = startYear; year <= endYear; ++year) {
+        LunarYearData data;
+        if (!LunarCalendar::GetLunarCalendar(year)->toYearData(data)) {
+            fprintf(stderr, "lunar year %d cannot be stored in the table\n", year);
+            return 1;
+        }
+        QStringList termDays;
+        for (int i = 0; i < 24; ++i) {
+            termDays.append(QString::number(data.solarTermYearDays[i]));
+        }
+        stream << QString("    {%1, 0x%2, %3, {%4}}, // %5\n")
+                      .arg(data.firstShuoDay)
+                      .arg(data.bigMonthBits, 4, 16, QChar('0'))
+                      .arg(data.leapMonth)
+                      .arg(termDays.join(", "))
+                      .arg(year);
+    }
+    stream << "};\n";
+    stream.flush();
+    LunarCalendar::LogOffEmptyData();
+
+    QFile file(argv[3]);
+    if (!file.open(QIODevice::WriteOnly | QIODevice::Truncate)) {
+        fprintf(stderr, "cannot open %s\n", argv[3]);
+        return 1;
+    }
+    file.write(content.toUtf8());
+    file.close();
+    return 0;
+}
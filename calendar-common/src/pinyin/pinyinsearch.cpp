@@ -3,30 +3,137 @@
 // SPDX-License-Identifier: LGPL-3.0-or-later
 
 #include "pinyinsearch.h"
-#include "pinyindict.h"
-#include "commondef.h"
-#include <QRegularExpression>
-#include <QFile>
-#include <QTextStream>
-#include <QDebug>
 
-pinyinsearch *pinyinsearch::m_pinyinsearch = nullptr;
-QMap<int, QString> pinyinsearch::pinyinDictVector {};
+#include <QLatin1String>
+#include <QVarLengthArray>
+
+namespace {
+//合法拼音字典树节点，0号节点为根节点
+struct PinyinTrieNode {
+    quint16 firstChild; //第一个子节点，0表示没有子节点
+    quint16 nextSibling; //下一个兄弟节点，0表示没有兄弟节点
+    char letter;
+    bool terminal; //从根节点到该节点组成一个合法拼音
+};
+
+//由pinyindictgen根据拼音字典生成的只读数据表
+#include "pinyindictdata.inc"
 
-const QString kDictFile = ":/pinyin.dict";
+const quint16 EmptyPage = 0xFFFF;
 
 /**
- * @brief pinyinsearch::pinyinsearch 构造函数，进行初始化
+ * @brief charSyllables  获取汉字对应的不带音调的拼音在PinyinCharSyllables中的范围
+ * @return               汉字没有拼音时返回false
  */
-pinyinsearch::pinyinsearch()
+inline bool charSyllables(QChar ch, int &begin, int &end)
+{
+    const quint16 page = PinyinPageIndex[ch.unicode() >> 8];
+    if (page == EmptyPage) {
+        return false;
+    }
+    const int index = page * 256 + (ch.unicode() & 0xFF);
+    begin = PinyinCharBegin[index];
+    end = PinyinCharBegin[index + 1];
+    return begin < end;
+}
+
+inline const QChar *syllableData(int syllable)
+{
+    return reinterpret_cast<const QChar *>(PinyinSyllableText + PinyinSyllableBegin[syllable]);
+}
+
+inline int syllableLength(int syllable)
+{
+    return PinyinSyllableBegin[syllable + 1] - PinyinSyllableBegin[syllable];
+}
+
+inline bool isPinyinLetter(QChar ch)
+{
+    return ch >= QLatin1Char('a') && ch <= QLatin1Char('z');
+}
+
+//拼音是否只包含小写字母
+bool isLetterSyllable(int syllable)
+{
+    const QChar *data = syllableData(syllable);
+    for (int i = 0; i < syllableLength(syllable); ++i) {
+        if (!isPinyinLetter(data[i])) {
+            return false;
+        }
+    }
+    return true;
+}
+
+/**
+ * @brief matchPinyinLength  获取字符串开头的合法拼音长度
+ * 取长度大于1的最长合法拼音，没有时按一个字母划分
+ */
+int matchPinyinLength(const QChar *data, int size)
+{
+    int length = 1;
+    int node = 0;
+    for (int i = 0; i < size; ++i) {
+        int child = PinyinTrie[node].firstChild;
+        while (child != 0 && QLatin1Char(PinyinTrie[child].letter) != data[i]) {
+            child = PinyinTrie[child].nextSibling;
+        }
+        if (child == 0) {
+            break;
+        }
+        node = child;
+        if (PinyinTrie[node].terminal && i > 0) {
+            length = i + 1;
+        }
+    }
+    return length;
+}
+
+/**
+ * @brief groupMatch     判断一个汉字的拼音是否与拼音片段匹配
+ * 与正则表达式“\[[a-z\|]*key[a-z\|]*\]”匹配CreatePinyin中该汉字拼音的结果一致：
+ * 拼音片段需要在其中一个拼音中出现，其余字符都为小写字母或分隔符
+ */
+bool groupMatch(int begin, int end, const QChar *key, int keyLength)
 {
-    for (int i = 0; i < validPinyinList.size(); i++) {
-        QString key = validPinyinList[i];
-        validPinyinMap[key] = true;
-        //拼音最大长度
-        if (key.size() > singlePinyinMaxLength)
-            singlePinyinMaxLength = key.size();
+    //包含非小写字母的拼音，最多只能有一个，且非小写字母需要在拼音片段中
+    int otherSyllable = -1;
+    for (int i = begin; i < end; ++i) {
+        const int syllable = PinyinCharSyllables[i];
+        if (!isLetterSyllable(syllable)) {
+            if (otherSyllable >= 0) {
+                return false;
+            }
+            otherSyllable = syllable;
+        }
     }
+    for (int i = begin; i < end; ++i) {
+        const int syllable = PinyinCharSyllables[i];
+        if (otherSyllable >= 0 && syllable != otherSyllable) {
+            continue;
+        }
+        const QChar *data = syllableData(syllable);
+        const int length = syllableLength(syllable);
+        for (int pos = 0; pos + keyLength <= length; ++pos) {
+            bool found = true;
+            for (int k = 0; k < keyLength && found; ++k) {
+                found = data[pos + k] == key[k];
+            }
+            for (int k = 0; k < length && found && otherSyllable >= 0; ++k) {
+                found = (k >= pos && k < pos + keyLength) || isPinyinLetter(data[k]);
+            }
+            if (found) {
+                return true;
+            }
+        }
+    }
+    return false;
+}
+} // namespace
+
+pinyinsearch *pinyinsearch::m_pinyinsearch = nullptr;
+
+pinyinsearch::pinyinsearch()
+{
 }
 
 pinyinsearch *pinyinsearch::getPinPinSearch()
@@ -34,67 +141,53 @@ pinyinsearch *pinyinsearch::getPinPinSearch()
     if (m_pinyinsearch == nullptr) {
         //new pinyinsearch
         m_pinyinsearch = new pinyinsearch();
-        //获取拼音字典
-        initDict();
     }
     return m_pinyinsearch;
 }
 
 /**
- * @brief pinyinsearch::canQueryByPinyin 拼音是否与正则表达式匹配
+ * @brief pinyinsearch::canQueryByPinyin 字符串是否只包含英文字母
  * @param str 拼音字符串
  * @return bool值
  */
 bool pinyinsearch::CanQueryByPinyin(QString str)
 {
-    QRegExp regexp("^[a-zA-Z]+$");
-    return regexp.exactMatch(str);
+    if (str.isEmpty()) {
+        return false;
+    }
+    for (const QChar &ch : str) {
+        if (ch.unicode() > 0x7F || !ch.isLetter()) {
+            return false;
+        }
+    }
+    return true;
 }
 
 /**
  * @brief pinyinsearch::createPinyin 创建拼音字符串
  * @param zh 汉字字符串
- * @return 拼音字符串
+ * @return 拼音字符串，每个汉字的拼音放在[]中，多音字的拼音用“|”区分
  */
 QString pinyinsearch::CreatePinyin(const QString &zh)
 {
-    //返回中文对应的拼音，汉字个数对应QList长度，每个汉字拥有的拼音个数对应QStringList长度
-    QList<QStringList> pyList = Pinyin(zh);
     QString pinyinStr;
-    for (int i = 0; i < pyList.count(); i++) {
-        //如果一个汉字有多个拼音，把“|”放在中间，以示区分
-        QString pyStr = pyList.at(i).join("|");
-        //将每个汉字的拼音放在[]中
-        if (!pyStr.isEmpty())
-            pinyinStr += "[" + pyStr + "]";
-    }
-    return pinyinStr;
-}
-
-void pinyinsearch::initDict()
-{
-    if (!pinyinDictVector.isEmpty()) {
-        return;
-    }
-
-    QFile file(kDictFile);
-
-    if (!file.open(QIODevice::ReadOnly)) {
-        qCWarning(ServiceLogger) << "open dictFile error :" << file.error();
-        return;
-    }
-
-    QByteArray content = file.readAll();
-    file.close();
-    QTextStream stream(&content, QIODevice::ReadOnly);
-    while (!stream.atEnd()) {
-        const QString line = stream.readLine();
-        const QStringList items = line.split(QChar(':'));
-
-        if (items.size() == 2) {
-            pinyinDictVector.insert(items[0].toInt(nullptr, 16), items[1]);
+    int begin = 0;
+    int end = 0;
+    for (const QChar &ch : zh) {
+        if (!charSyllables(ch, begin, end)) {
+            continue;
         }
+        pinyinStr.append(QLatin1Char('['));
+        for (int i = begin; i < end; ++i) {
+            if (i > begin) {
+                pinyinStr.append(QLatin1Char('|'));
+            }
+            const int syllable = PinyinCharSyllables[i];
+            pinyinStr.append(syllableData(syllable), syllableLength(syllable));
+        }
+        pinyinStr.append(QLatin1Char(']'));
     }
+    return pinyinStr;
 }
 
 /**
@@ -105,27 +198,16 @@ void pinyinsearch::initDict()
 QString pinyinsearch::CreatePinyinQuery(QString pinyin) const
 {
     QString expr;
+    expr.reserve(pinyin.size() * 5);
     //对传入的拼音进行划分，例如：“nihao”->"[%ni%][%hao%]"
-    while (pinyin.size() > 0) {
-        //拼音最大长度
-        int i = singlePinyinMaxLength;
-        if (i > pinyin.size()) {
-            i = pinyin.size();
-        }
-        while (i > 1) {
-            //从拼音最大长度，递减截取拼音，是否在字典中
-            QString key = pinyin.mid(0, i);
-            //如果拼音在字典中，则此拼音代表一个汉字的拼音，break
-            if (validPinyinMap[key])
-                break;
-            i--;
-        }
+    const QChar *data = pinyin.constData();
+    for (int pos = 0; pos < pinyin.size();) {
         //一个汉字的拼音
-        QString key = pinyin.mid(0, i);
-        //对剩下的字符串再次进行解析
-        pinyin = pinyin.mid(i, pinyin.size());
-        //对每个汉字的拼音进行区分
-        expr += "[%" + key + "%]";
+        const int length = matchPinyinLength(data + pos, pinyin.size() - pos);
+        expr.append(QLatin1String("[%"));
+        expr.append(data + pos, length);
+        expr.append(QLatin1String("%]"));
+        pos += length;
     }
     return expr;
 }
@@ -138,110 +220,56 @@ QString pinyinsearch::CreatePinyinQuery(QString pinyin) const
 QString pinyinsearch::CreatePinyinRegexp(QString pinyin) const
 {
     QString expr;
-    while (pinyin.size() > 0) {
-        int i = singlePinyinMaxLength;
-        if (i > pinyin.size()) {
-            i = pinyin.size();
-        }
-        while (i > 1) {
-            QString key = pinyin.mid(0, i);
-            if (validPinyinMap[key]) {
-                break;
-            }
-            i--;
-        }
-        QString key = pinyin.mid(0, i);
-        pinyin = pinyin.mid(i, pinyin.size());
-        expr += "\\[[a-z\\|]*" + key + "[a-z\\|]*\\]";
+    const QChar *data = pinyin.constData();
+    for (int pos = 0; pos < pinyin.size();) {
+        const int length = matchPinyinLength(data + pos, pinyin.size() - pos);
+        expr.append(QLatin1String("\\[[a-z\\|]*"));
+        expr.append(data + pos, length);
+        expr.append(QLatin1String("[a-z\\|]*\\]"));
+        pos += length;
     }
     return expr;
 }
 
 /**
  * @brief pinyinsearch::pinyinMatch 判断汉字和拼音是否匹配
+ * 结果与CreatePinyinRegexp生成的正则表达式匹配CreatePinyin的结果一致，py只包含字母
  * @param zh 汉字
  * @param py 汉字对应的拼音
  * @return bool值
  */
 bool pinyinsearch::PinyinMatch(const QString &zh, const QString &py) const
 {
-    //获取汉字的拼音
-    QString zhPinyin = CreatePinyin(zh);
-    //获取拼音的正则表达式
-    QString expr = CreatePinyinRegexp(py);
-    //QRegularExpression类使用正则表达式提供模式匹配。
-    QRegularExpression regexp(expr);
-    //根据给定的主题字符串匹配正则表达式,返回的QRegularExpressionMatch对象包含匹配的结果。
-    QRegularExpressionMatch match = regexp.match(zhPinyin);
-    //拼音是否与正则表达式匹配
-    return match.hasMatch();
-}
-
-/**
- * @brief pinyinsearch::Pinyin 获取汉字的拼音
- * @param str 汉字
- * @return 汉字对应的拼音
- */
-QList<QStringList> pinyinsearch::Pinyin(QString str)
-{
-    QList<QStringList> pys {};
-    QStringList py;
-    for (int i = 0; i < str.count(); i++) {
-        //每个汉字对应的拼音
-        py = SinglePinyin(str.at(i));
-        if (py.size() > 0) {
-            //将去掉音调的拼音添加到Qlist中
-            pys.append(RemoveYin(py));
-        }
+    //按汉字划分拼音，每段的长度
+    QVarLengthArray<int, 32> keyLengths;
+    for (int pos = 0; pos < py.size();) {
+        keyLengths.append(matchPinyinLength(py.constData() + pos, py.size() - pos));
+        pos += keyLengths.last();
     }
-    return pys;
-}
-
-/**
- * @brief pinyinsearch::SinglePinyin 通过字典找到汉字对应的拼音
- * @param index 汉字
- * @return 拼音
- */
-QStringList pinyinsearch::SinglePinyin(QString index)
-{
-    //通过汉字的编码找到对应的拼音
-    QString value;
-    //查找对应的拼音
-    const int unicode = index.data()->unicode();
-
-    if (pinyinDictVector.contains(unicode)) {
-        value = pinyinDictVector[index.data()->unicode()];
+    if (keyLengths.isEmpty()) {
+        return true;
     }
-    QStringList pys {};
-    pys = value.split(",");
-    return pys;
-}
-
-/**
- * @brief pinyinsearch::removeYin 去掉拼音中的音调
- * @param pinyin 带有音调的拼音
- * @return 不带音调的拼音
- */
-QStringList pinyinsearch::RemoveYin(QStringList pinyin)
-{
-    QString str;
-    QStringList strList;
-    //遍历每个拼音
-    for (int i = 0; i < pinyin.size(); i++) {
-        //遍历拼音中的每个字母，对带有音调的进行处理
-        for (int j = 0; j < pinyin.at(i).size(); j++) {
-            QString s = pinyin.at(i).at(j);
-            //如果有音调转换为不带音调的字母，否则使用原字母
-            if (phoneticSymbol.contains(s)) {
-                str.append(phoneticSymbol[s][0]);
-            } else {
-                str.append(s);
+    int begin = 0;
+    int end = 0;
+    //没有拼音的字符不参与匹配，从每个有拼音的汉字开始依次匹配每段拼音
+    for (int start = 0; start < zh.size(); ++start) {
+        if (!charSyllables(zh.at(start), begin, end)) {
+            continue;
+        }
+        int index = start;
+        int keyPos = 0;
+        bool matched = true;
+        for (int k = 0; k < keyLengths.size() && matched; ++k) {
+            while (index < zh.size() && !charSyllables(zh.at(index), begin, end)) {
+                ++index;
             }
+            matched = index < zh.size() && groupMatch(begin, end, py.constData() + keyPos, keyLengths.at(k));
+            keyPos += keyLengths.at(k);
+            ++index;
+        }
+        if (matched) {
+            return true;
         }
-        //一个拼音可能有多种音调，所以需要去重
-        if (!strList.contains(str))
-            strList.append(str);
-        str.clear();
     }
-    return strList;
+    return false;
 }
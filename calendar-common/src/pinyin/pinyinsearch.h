@@ -5,9 +5,10 @@
 #ifndef PINYINSEARCH_H
 #define PINYINSEARCH_H
 
-#include <QVector>
-#include <QMap>
+#include <QString>
 
+//拼音查询
+//拼音字典在编译时生成只读数据表，查询时不需要加载字典，也不会为中间结果分配内存
 class pinyinsearch
 {
 public:
@@ -16,8 +17,6 @@ public:
     static bool CanQueryByPinyin(QString str);
     /* 创建拼音字符串 */
     static QString CreatePinyin(const QString &zh);
-    //初始化字典
-    static void initDict();
     /* 构造拼音查询表达式 */
     QString CreatePinyinQuery(QString pinyin) const;
     /* 构造拼音查询正则表达式 */
@@ -26,21 +25,8 @@ public:
     bool PinyinMatch(const QString &zh, const QString &py) const;
 
 private:
-    /* 初始化合法拼音表 */
     pinyinsearch();
-    //获取汉字对应的拼音，不带音调
-    static QList<QStringList> Pinyin(QString str);
-    //找到汉字对应的拼音
-    static QStringList SinglePinyin(QString index);
-    //去掉拼音中的音调
-    static QStringList RemoveYin(QStringList pinyin);
-    /* 单个合法拼音的最大长度 */
-    int singlePinyinMaxLength = 0;
-    /* 合法单拼音表 */
-    QMap<QString, bool> validPinyinMap {};
     static pinyinsearch *m_pinyinsearch;
-    //拼音字典
-    static QMap<int, QString> pinyinDictVector;
 };
 
 #endif
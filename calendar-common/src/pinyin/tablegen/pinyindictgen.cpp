@@ -0,0 +1,202 @@
+// SPDX-FileCopyrightText: 2019 - 2022 UnionTech Software Technology Co., Ltd.
+//
+// SPDX-License-Identifier: LGPL-3.0-or-later
+
+//编译时将拼音字典转换为只读数据表
+//用法：pinyindictgen <拼音字典文件> <输出文件>
+//拼音字典每行格式为“0x3007:líng,yuán,xīng”，输出的拼音去掉音调并去重
+
+#include "pinyindict.h"
+
+#include <QFile>
+#include <QTextStream>
+#include <QStringList>
+#include <QHash>
+
+#include <cstdio>
+
+namespace {
+//每页包含的字符数量，按unicode编码高8位分页
+const int PageSize = 256;
+const int PageCount = 65536 / PageSize;
+const quint16 EmptyPage = 0xFFFF;
+
+struct TrieNode {
+    quint16 firstChild = 0;
+    quint16 nextSibling = 0;
+    char letter = 0;
+    bool terminal = false;
+};
+
+//去掉拼音中的音调，与原有的按字符替换规则保持一致
+QString removeYin(const QString &pinyin)
+{
+    QString str;
+    for (int i = 0; i < pinyin.size(); ++i) {
+        const QString s = pinyin.at(i);
+        if (phoneticSymbol.contains(s)) {
+            str.append(phoneticSymbol[s][0]);
+        } else {
+            str.append(s);
+        }
+    }
+    return str;
+}
+
+//将数组按每行16个元素输出
+template<typename T>
+void writeArray(QTextStream &stream, const QString &declaration, const QVector<T> &values)
+{
+    stream << declaration << " = {";
+    for (int i = 0; i < values.size(); ++i) {
+        stream << (i % 16 == 0 ? "\n    " : " ") << values.at(i) << ",";
+    }
+    stream << "\n};\n";
+}
+
+//将合法拼音插入字典树，子节点按字母顺序排列
+bool insertTrie(QVector<TrieNode> &trie, const QString &pinyin)
+{
+    int node = 0;
+    for (int i = 0; i < pinyin.size(); ++i) {
+        const char letter = pinyin.at(i).toLatin1();
+        if (letter < 'a' || letter > 'z') {
+            return false;
+        }
+        int prev = 0;
+        int child = trie[node].firstChild;
+        while (child != 0 && trie[child].letter < letter) {
+            prev = child;
+            child = trie[child].nextSibling;
+        }
+        if (child == 0 || trie[child].letter != letter) {
+            TrieNode newNode;
+            newNode.letter = letter;
+            newNode.nextSibling = static_cast<quint16>(child);
+            trie.append(newNode);
+            const quint16 index = static_cast<quint16>(trie.size() - 1);
+            if (prev == 0) {
+                trie[node].firstChild = index;
+            } else {
+                trie[prev].nextSibling = index;
+            }
+            child = index;
+        }
+        node = child;
+    }
+    trie[node].terminal = true;
+    return true;
+}
+} // namespace
+
+int main(int argc, char *argv[])
+{
+    if (argc != 3) {
+        fprintf(stderr, "usage: %s <pinyin dict> <output file>\n", argv[0]);
+        return 1;
+    }
+    QFile dictFile(argv[1]);
+    if (!dictFile.open(QIODevice::ReadOnly)) {
+        fprintf(stderr, "cannot open %s\n", argv[1]);
+        return 1;
+    }
+
+    //每个字符对应的拼音，只处理基本平面的字符，与按QChar查找拼音的方式一致
+    QVector<QStringList> charPinyin(65536);
+    QStringList syllables;
+    QTextStream dictStream(&dictFile);
+    dictStream.setCodec("UTF-8");
+    while (!dictStream.atEnd()) {
+        const QStringList items = dictStream.readLine().split(QChar(':'));
+        if (items.size() != 2) {
+            continue;
+        }
+        const int unicode = items[0].toInt(nullptr, 16);
+        if (unicode <= 0 || unicode >= 65536) {
+            continue;
+        }
+        foreach (const QString &pinyin, items[1].split(",")) {
+            const QString str = removeYin(pinyin);
+            //一个拼音可能有多种音调，所以需要去重
+            if (!str.isEmpty() && !charPinyin[unicode].contains(str)) {
+                charPinyin[unicode].append(str);
+            }
+        }
+        syllables.append(charPinyin[unicode]);
+    }
+    syllables.removeDuplicates();
+    syllables.sort();
+
+    QHash<QString, quint16> syllableIndex;
+    QVector<quint16> syllableBegin;
+    QVector<quint16> syllableText;
+    foreach (const QString &syllable, syllables) {
+        syllableIndex.insert(syllable, static_cast<quint16>(syllableBegin.size()));
+        syllableBegin.append(static_cast<quint16>(syllableText.size()));
+        for (int i = 0; i < syllable.size(); ++i) {
+            syllableText.append(syllable.at(i).unicode());
+        }
+    }
+    syllableBegin.append(static_cast<quint16>(syllableText.size()));
+
+    QVector<quint16> pageIndex(PageCount, EmptyPage);
+    QVector<quint16> charBegin;
+    QVector<quint16> charSyllables;
+    for (int page = 0; page < PageCount; ++page) {
+        bool empty = true;
+        for (int i = 0; i < PageSize && empty; ++i) {
+            empty = charPinyin[page * PageSize + i].isEmpty();
+        }
+        if (empty) {
+            continue;
+        }
+        pageIndex[page] = static_cast<quint16>(charBegin.size() / PageSize);
+        for (int i = 0; i < PageSize; ++i) {
+            charBegin.append(static_cast<quint16>(charSyllables.size()));
+            foreach (const QString &syllable, charPinyin[page * PageSize + i]) {
+                charSyllables.append(syllableIndex.value(syllable));
+            }
+            if (charSyllables.size() > 0xFFFF) {
+                fprintf(stderr, "too many pinyin entries for 16-bit offsets\n");
+                return 1;
+            }
+        }
+    }
+    charBegin.append(static_cast<quint16>(charSyllables.size()));
+
+    QVector<TrieNode> trie(1);
+    foreach (const QString &pinyin, validPinyinList) {
+        if (!insertTrie(trie, pinyin)) {
+            fprintf(stderr, "invalid pinyin %s\n", qPrintable(pinyin));
+            return 1;
+        }
+    }
+
+    QString content;
+    QTextStream stream(&content);
+    stream << "// generated by pinyindictgen, do not edit\n";
+    writeArray(stream, "static const ushort PinyinSyllableText[]", syllableText);
+    writeArray(stream, "static const quint16 PinyinSyllableBegin[]", syllableBegin);
+    writeArray(stream, "static const quint16 PinyinPageIndex[]", pageIndex);
+    writeArray(stream, "static const quint16 PinyinCharBegin[]", charBegin);
+    writeArray(stream, "static const quint16 PinyinCharSyllables[]", charSyllables);
+    stream << "static const PinyinTrieNode PinyinTrie[] = {\n";
+    foreach (const TrieNode &node, trie) {
+        stream << QString("    {%1, %2, '%3', %4},\n")
+                      .arg(node.firstChild)
+                      .arg(node.nextSibling)
+                      .arg(node.letter == 0 ? QString("\\0") : QString(node.letter))
+                      .arg(node.terminal ? "true" : "false");
+    }
+    stream << "};\n";
+    stream.flush();
+
+    QFile file(argv[2]);
+    if (!file.open(QIODevice::WriteOnly | QIODevice::Truncate)) {
+        fprintf(stderr, "cannot open %s\n", argv[2]);
+        return 1;
+    }
+    file.write(content.toUtf8());
+    file.close();
+    return 0;
+}
@@ -24,6 +24,35 @@ QDateTime dtConvert(const QDateTime &datetime)
     return dt;
 }
 
+QString icsTextProperty(const QString &name, const QString &value)
+{
+    //先转义反斜杠，回车统一为换行后转义
+    QString text = value;
+    text.replace(QLatin1Char('\\'), QLatin1String("\\\\"))
+        .replace(QLatin1Char(';'), QLatin1String("\\;"))
+        .replace(QLatin1Char(','), QLatin1String("\\,"))
+        .replace(QLatin1String("\r\n"), QLatin1String("\n"))
+        .replace(QLatin1Char('\r'), QLatin1Char('\n'))
+        .replace(QLatin1Char('\n'), QLatin1String("\\n"));
+    const QByteArray line = QString(name + ':' + text).toUtf8();
+    //每行不超过75字节，续行以空格开头，不拆分多字节字符
+    QByteArray data;
+    int start = 0;
+    int maxLength = 75;
+    while (line.size() - start > maxLength) {
+        int end = start + maxLength;
+        while (end > start && (static_cast<uchar>(line.at(end)) & 0xC0) == 0x80) {
+            --end;
+        }
+        data.append(line.mid(start, end - start)).append("\r\n ");
+        start = end;
+        //续行开头的空格占一个字节
+        maxLength = 74;
+    }
+    data.append(line.mid(start)).append("\r\n");
+    return QString::fromUtf8(data);
+}
+
 QDateTime dtFromString(const QString &st)
 {
     QDateTime &&dtSt = QDateTime::fromString(st, Qt::ISODate);
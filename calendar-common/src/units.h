@@ -48,6 +48,15 @@ QSharedPointer<QProcess> DownloadFile(QString url, QString filename);
 //时间转换
 QDateTime dtConvert(const QDateTime &datetime);
 
+/**
+ * @brief icsTextProperty       生成ics中TEXT类型的属性行
+ * 取值中的反斜杠、分号、逗号和换行会被转义，超过75字节的行按UTF-8字符边界折行
+ * @param name                  属性名
+ * @param value                 属性值
+ * @return                      以CRLF结尾的属性行
+ */
+QString icsTextProperty(const QString &name, const QString &value);
+
 //是否在显示时间范围内1900-2100
 bool withinTimeFrame(const QDate &date);
 
@@ -6,8 +6,11 @@
 
 #include "commondef.h"
 #include "csystemdtimercontrol.h"
+#include "dremindtimer.h"
+#include "units.h"
 #include "dbus/dbusnotify.h"
 #include <QLoggingCategory>
+#include <QSettings>
 
 #define Millisecond 1
 #define Second 1000 * Millisecond
@@ -23,9 +26,12 @@ static QString notifyActKeyRemindAfter4hours("later-4hours");
 static QString notifyActKeyRemind1DayBefore("one-day-before");
 static QString notifyActKeyRemindTomorrow("tomorrow");
 static QString layoutHM("15:04");
+static QString remindBackendKey("remindBackend");
+static QString remindBackendSystemd("systemd");
 
 DAlarmManager::DAlarmManager(QObject *parent)
     : QObject(parent)
+    , m_useSystemdTimer(useSystemdTimer())
 {
     m_dbusnotify = new DBusNotify("org.deepin.dde.Notification1",
                                   "/org/deepin/dde/Notification1",
@@ -46,16 +52,25 @@ DAlarmManager::DAlarmManager(QObject *parent)
     systemdTimer.startCalendarServiceSystemdTimer();
 }
 
-void DAlarmManager::updateRemind(const DRemindData::List &remindList)
+bool DAlarmManager::useSystemdTimer()
+{
+    QSettings settings(getAppConfigDir().filePath("config.ini"), QSettings::IniFormat);
+    if (settings.value(remindBackendKey).toString() == remindBackendSystemd) {
+        return true;
+    }
+    return !DRemindTimer::instance()->isValid();
+}
+
+void DAlarmManager::updateRemind(const QString &accountID, const DRemindData::List &remindList)
 {
     qCDebug(ServiceLogger) << "updateRemind" << "list size:" << remindList.size();
-    if (remindList.size() == 0)
-        return;
-    QString &&accountID = remindList.at(0)->accountID();
+    //提醒任务为空时同样需要清空原有的任务
     CSystemdTimerControl systemdTimerControl;
-    //清空该帐户下日程提醒
-    systemdTimerControl.stopAllRemindSystemdTimer(accountID);
-    systemdTimerControl.removeRemindFile(accountID);
+    //清空该帐户下日程提醒,使用进程内定时器时只清理切换前遗留的systemd任务
+    if (m_useSystemdTimer || systemdTimerControl.hasRemindFile(accountID)) {
+        systemdTimerControl.stopAllRemindSystemdTimer(accountID);
+        systemdTimerControl.removeRemindFile(accountID);
+    }
 
     QVector<SystemDInfo> infoVector {};
     foreach (auto remind, remindList) {
@@ -66,7 +81,13 @@ void DAlarmManager::updateRemind(const DRemindData::List &remindList)
         info.triggerTimer = remind->dtRemind();
         infoVector.append(info);
     }
-    systemdTimerControl.buildingConfiggure(infoVector);
+    if (m_useSystemdTimer) {
+        if (!infoVector.isEmpty()) {
+            systemdTimerControl.buildingConfiggure(infoVector);
+        }
+    } else {
+        DRemindTimer::instance()->setRemindJobs(accountID, infoVector);
+    }
 }
 
 void DAlarmManager::notifyJobsChanged(const DRemindData::List &remindList)
@@ -84,7 +105,11 @@ void DAlarmManager::notifyJobsChanged(const DRemindData::List &remindList)
         info.triggerTimer = remind->dtRemind();
         infoVector.append(info);
     }
-    systemdTimerControl.stopSystemdTimerByJobInfos(infoVector);
+    if (m_useSystemdTimer) {
+        systemdTimerControl.stopSystemdTimerByJobInfos(infoVector);
+    } else {
+        DRemindTimer::instance()->removeRemindJobs(infoVector);
+    }
 }
 
 void DAlarmManager::notifyMsgHanding(const DRemindData::Ptr &remindData, const int operationNum)
@@ -109,10 +134,17 @@ void DAlarmManager::notifyMsgHanding(const DRemindData::Ptr &remindData, const i
 
 void DAlarmManager::remindLater(const DRemindData::Ptr &remindData, const int operationNum)
 {
-    CSystemdTimerControl systemdTimerControl;
     SystemDInfo info;
     info.accountID = remindData->accountID();
     info.alarmID = remindData->alarmID();
+    if (!m_useSystemdTimer) {
+        //相同提醒编号的任务会被替换
+        info.laterCount = remindData->remindCount();
+        info.triggerTimer = remindData->dtRemind();
+        DRemindTimer::instance()->addRemindJob(info);
+        return;
+    }
+    CSystemdTimerControl systemdTimerControl;
     //如果是稍后提醒则设置对应的重复次数
     if (operationNum == 2) {
         info.laterCount = remindData->remindCount();
@@ -20,8 +20,17 @@ public:
     typedef QSharedPointer<DAlarmManager> Ptr;
 
     explicit DAlarmManager(QObject *parent = nullptr);
-    //更新提醒任务
-    void updateRemind(const DRemindData::List &remindList);
+    /**
+     * @brief useSystemdTimer   是否使用systemd定时任务触发提醒
+     * 默认使用进程内定时器，配置文件config.ini中remindBackend为systemd或timerfd不可用时使用systemd
+     */
+    static bool useSystemdTimer();
+    /**
+     * @brief updateRemind      替换帐户下所有的提醒任务
+     * @param accountID         帐户id
+     * @param remindList        提醒任务，为空时清空帐户下的提醒任务
+     */
+    void updateRemind(const QString &accountID, const DRemindData::List &remindList);
     void notifyJobsChanged(const DRemindData::List &remindList);
 
     /**
@@ -52,6 +61,7 @@ signals:
 
 private:
     DBusNotify *m_dbusnotify; //日程提醒dbus操作相关
+    bool m_useSystemdTimer; //是否使用systemd定时任务触发提醒
 };
 
 #endif // DALARMMANAGER_H
@@ -0,0 +1,175 @@
+// SPDX-FileCopyrightText: 2019 - 2022 UnionTech Software Technology Co., Ltd.
+//
+// SPDX-License-Identifier: LGPL-3.0-or-later
+
+#include "dremindtimer.h"
+
+#include "commondef.h"
+#include "calendarprogramexitcontrol.h"
+
+#include <QCoreApplication>
+#include <QSocketNotifier>
+#include <QDateTime>
+#include <QLoggingCategory>
+
+#include <algorithm>
+
+#include <sys/timerfd.h>
+#include <unistd.h>
+#include <errno.h>
+#include <string.h>
+
+static DRemindTimer *remindTimer = nullptr;
+
+DRemindTimer *DRemindTimer::instance()
+{
+    if (remindTimer == nullptr) {
+        remindTimer = new DRemindTimer;
+        //包含QSocketNotifier，需要在QCoreApplication析构前释放，不能使用静态局部对象
+        if (QCoreApplication::instance() != nullptr) {
+            connect(QCoreApplication::instance(), &QCoreApplication::aboutToQuit, [] {
+                delete remindTimer;
+                remindTimer = nullptr;
+            });
+        }
+    }
+    return remindTimer;
+}
+
+DRemindTimer::DRemindTimer(QObject *parent)
+    : QObject(parent)
+    , m_timerFd(timerfd_create(CLOCK_REALTIME, TFD_NONBLOCK | TFD_CLOEXEC))
+{
+    if (m_timerFd < 0) {
+        qCWarning(ServiceLogger) << "timerfd_create failed:" << strerror(errno);
+        return;
+    }
+    m_notifier = new QSocketNotifier(m_timerFd, QSocketNotifier::Read, this);
+    //Qt5.15中activated存在重载，使用字符串形式关联
+    connect(m_notifier, SIGNAL(activated(int)), this, SLOT(slotTimeout()));
+}
+
+DRemindTimer::~DRemindTimer()
+{
+    if (m_timerFd >= 0) {
+        close(m_timerFd);
+    }
+}
+
+template<typename Pred>
+void DRemindTimer::removeIf(Pred pred)
+{
+    auto iter = std::remove_if(m_jobs.begin(), m_jobs.end(), pred);
+    if (iter == m_jobs.end()) {
+        return;
+    }
+    m_jobs.erase(iter, m_jobs.end());
+    std::make_heap(m_jobs.begin(), m_jobs.end(), laterThan);
+}
+
+bool DRemindTimer::isValid() const
+{
+    return m_timerFd >= 0;
+}
+
+void DRemindTimer::setRemindJobs(const QString &accountID, const QVector<SystemDInfo> &infoVector)
+{
+    removeIf([&](const RemindJob &job) {
+        return job.accountID == accountID;
+    });
+    foreach (auto info, infoVector) {
+        m_jobs.append({info.triggerTimer.toMSecsSinceEpoch(), accountID, info.alarmID});
+        std::push_heap(m_jobs.begin(), m_jobs.end(), laterThan);
+    }
+    rearm();
+    updateExitControl();
+}
+
+void DRemindTimer::addRemindJob(const SystemDInfo &info)
+{
+    removeIf([&](const RemindJob &job) {
+        return job.accountID == info.accountID && job.alarmID == info.alarmID;
+    });
+    m_jobs.append({info.triggerTimer.toMSecsSinceEpoch(), info.accountID, info.alarmID});
+    std::push_heap(m_jobs.begin(), m_jobs.end(), laterThan);
+    rearm();
+    updateExitControl();
+}
+
+void DRemindTimer::removeRemindJobs(const QVector<SystemDInfo> &infoVector)
+{
+    removeIf([&](const RemindJob &job) {
+        return std::any_of(infoVector.begin(), infoVector.end(), [&](const SystemDInfo &info) {
+            return job.accountID == info.accountID && job.alarmID == info.alarmID;
+        });
+    });
+    rearm();
+    updateExitControl();
+}
+
+int DRemindTimer::count() const
+{
+    return m_jobs.size();
+}
+
+void DRemindTimer::rearm()
+{
+    if (m_timerFd < 0) {
+        return;
+    }
+    struct itimerspec spec;
+    memset(&spec, 0, sizeof(spec));
+    if (!m_jobs.isEmpty()) {
+        //全为0时表示停止定时器，已过期的任务设置为最小的时间立即触发
+        const qint64 msecs = std::max<qint64>(m_jobs.first().triggerMsecs, 1);
+        spec.it_value.tv_sec = static_cast<time_t>(msecs / 1000);
+        spec.it_value.tv_nsec = static_cast<long>(msecs % 1000) * 1000000;
+    }
+    //系统时间被修改时timerfd会被唤醒，重新计算需要触发的任务
+    if (timerfd_settime(m_timerFd, TFD_TIMER_ABSTIME | TFD_TIMER_CANCEL_ON_SET, &spec, nullptr) < 0) {
+        qCWarning(ServiceLogger) << "timerfd_settime failed:" << strerror(errno);
+    }
+}
+
+void DRemindTimer::slotTimeout()
+{
+    //读取超时次数，系统时间被修改时返回ECANCELED，均不影响后续处理
+    quint64 expirations = 0;
+    if (read(m_timerFd, &expirations, sizeof(expirations)) < 0 && errno != EAGAIN && errno != ECANCELED) {
+        qCWarning(ServiceLogger) << "read timerfd failed:" << strerror(errno);
+    }
+
+    const qint64 currentMsecs = QDateTime::currentMSecsSinceEpoch();
+    QVector<RemindJob> dueJobs;
+    while (!m_jobs.isEmpty() && m_jobs.first().triggerMsecs <= currentMsecs) {
+        std::pop_heap(m_jobs.begin(), m_jobs.end(), laterThan);
+        dueJobs.append(m_jobs.takeLast());
+    }
+    rearm();
+
+    foreach (auto job, dueJobs) {
+        qCDebug(ServiceLogger) << "remind job" << job.accountID << job.alarmID;
+        emit signalRemindJob(job.accountID, job.alarmID);
+    }
+    //提醒处理完成后再更新，避免处理过程中程序退出
+    updateExitControl();
+}
+
+void DRemindTimer::updateExitControl()
+{
+    const bool holdExit = !m_jobs.isEmpty();
+    if (holdExit == m_holdExit) {
+        return;
+    }
+    m_holdExit = holdExit;
+    if (holdExit) {
+        CalendarProgramExitControl::getProgramExitControl()->addExc();
+    } else {
+        CalendarProgramExitControl::getProgramExitControl()->reduce();
+    }
+}
+
+bool DRemindTimer::laterThan(const RemindJob &left, const RemindJob &right)
+{
+    return left.triggerMsecs > right.triggerMsecs;
+}
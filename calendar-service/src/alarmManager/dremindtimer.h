@@ -0,0 +1,83 @@
+// SPDX-FileCopyrightText: 2019 - 2022 UnionTech Software Technology Co., Ltd.
+//
+// SPDX-License-Identifier: LGPL-3.0-or-later
+
+#ifndef DREMINDTIMER_H
+#define DREMINDTIMER_H
+
+#include "csystemdtimercontrol.h"
+
+#include <QObject>
+#include <QVector>
+
+class QSocketNotifier;
+
+//进程内日程提醒定时器
+//所有帐户的提醒任务按触发时间保存在最小堆中，由一个timerfd定时到堆顶任务的触发时间
+//有待触发的提醒任务时阻止后端程序自动退出
+class DRemindTimer : public QObject
+{
+    Q_OBJECT
+public:
+    static DRemindTimer *instance();
+    ~DRemindTimer() override;
+
+    /**
+     * @brief isValid       timerfd是否创建成功
+     */
+    bool isValid() const;
+
+    /**
+     * @brief setRemindJobs     替换帐户下所有的提醒任务
+     * @param accountID         帐户id
+     * @param infoVector        提醒任务，为空时清空帐户下的提醒任务
+     */
+    void setRemindJobs(const QString &accountID, const QVector<SystemDInfo> &infoVector);
+
+    /**
+     * @brief addRemindJob      添加提醒任务，相同提醒编号的任务会被替换
+     */
+    void addRemindJob(const SystemDInfo &info);
+
+    /**
+     * @brief removeRemindJobs  根据帐户id和提醒编号移除提醒任务
+     */
+    void removeRemindJobs(const QVector<SystemDInfo> &infoVector);
+
+    //待触发的提醒任务数量
+    int count() const;
+
+signals:
+    //提醒任务触发
+    void signalRemindJob(const QString &accountID, const QString &alarmID);
+
+private slots:
+    //触发所有已到时间的提醒任务
+    void slotTimeout();
+
+private:
+    explicit DRemindTimer(QObject *parent = nullptr);
+    //根据堆顶任务重新设置timerfd
+    void rearm();
+    //根据待触发任务数量更新程序退出控制
+    void updateExitControl();
+
+private:
+    struct RemindJob {
+        qint64 triggerMsecs; //触发时间，毫秒时间戳
+        QString accountID;
+        QString alarmID;
+    };
+    //最小堆比较函数，触发时间早的任务在堆顶
+    static bool laterThan(const RemindJob &left, const RemindJob &right);
+    //移除满足条件的任务后重建堆
+    template<typename Pred>
+    void removeIf(Pred pred);
+
+    QVector<RemindJob> m_jobs;
+    int m_timerFd;
+    QSocketNotifier *m_notifier = nullptr;
+    bool m_holdExit = false;
+};
+
+#endif // DREMINDTIMER_H
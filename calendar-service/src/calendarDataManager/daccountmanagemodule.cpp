@@ -6,6 +6,7 @@
 #include "commondef.h"
 #include "units.h"
 #include "calendarprogramexitcontrol.h"
+#include "dremindtimer.h"
 #include <qstandardpaths.h>
 #include <DSysInfo>
 
@@ -36,6 +37,8 @@ DAccountManageModule::DAccountManageModule(QObject *parent)
                 this,
                 &DAccountManageModule::slotSettingChange);
     }
+    //进程内定时器触发的提醒
+    connect(DRemindTimer::instance(), &DRemindTimer::signalRemindJob, this, &DAccountManageModule::remindJob);
     m_isSupportUid = m_syncFileManage->getSyncoperation()->hasAvailable();
     //新文件路径
     QString newDbPath = getDBPath();
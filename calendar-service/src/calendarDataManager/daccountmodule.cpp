@@ -17,21 +17,32 @@
 #include "unionIDDav/dunioniddav.h"
 #include "ddatasyncbase.h"
 #include "dbusnotify.h"
+#include "doccurrencecache.h"
+#include "dscheduleoccurrence.h"
 
 #include <QDir>
 #include <QFile>
+#include <QTextStream>
+#include <QJsonDocument>
+#include <QJsonObject>
+
+#include <algorithm>
 
 #define UPDATEREMINDJOBTIMEINTERVAL 1000 * 60 * 10 //提醒任务更新时间间隔毫秒数（10分钟）
+//导入日程时每批次写入数据库的日程数量
+static const int ImportBatchSize = 500;
 
 DAccountModule::DAccountModule(const DAccount::Ptr &account, QObject *parent)
     : QObject(parent)
     , m_account(account)
     , m_accountDB(new DAccountDataBase(account))
+    , m_scheduleCache(new DScheduleCache)
     , m_alarm(new DAlarmManager)
     , m_dataSync(DSyncDataFactory::createDataSync(m_account))
 {
     QString newDbPath = getDBPath();
     m_accountDB->setDBPath(newDbPath + "/" + account->dbName());
+    m_accountDB->setScheduleCache(m_scheduleCache);
     m_accountDB->initDBData();
     m_accountDB->getAccountInfo(m_account);
 
@@ -40,6 +51,7 @@ DAccountModule::DAccountModule(const DAccount::Ptr &account, QObject *parent)
     if (m_dataSync != nullptr) {
         connect(m_dataSync, &DDataSyncBase::signalSyncState, this, &DAccountModule::slotSyncState);
         connect(m_dataSync, &DDataSyncBase::signalUpdate, this, &DAccountModule::slotDateUpdate);
+        connect(m_dataSync, &DDataSyncBase::signalScheduleChanged, this, &DAccountModule::scheduleChanged);
     }
     //关联关闭提醒弹窗
     connect(this, &DAccountModule::signalCloseNotification, m_alarm->getdbusnotify(), &DBusNotify::closeNotification);
@@ -53,6 +65,12 @@ DAccountModule::~DAccountModule()
     }
 }
 
+DAccountDataBase::Ptr DAccountModule::accountDB()
+{
+    m_accountDB->completeDBData();
+    return m_accountDB;
+}
+
 QString DAccountModule::getAccountInfo()
 {
     QString accountInfo;
@@ -69,7 +87,7 @@ void DAccountModule::setExpand(const bool &isExpand)
 {
     if (m_account->isExpandDisplay() != isExpand) {
         m_account->setIsExpandDisplay(isExpand);
-        m_accountDB->updateAccountInfo();
+        accountDB()->updateAccountInfo();
     }
 }
 
@@ -82,7 +100,7 @@ void DAccountModule::setAccountState(const int accountState)
 {
     if (int(m_account->accountState()) != accountState) {
         m_account->setAccountState(static_cast<DAccount::AccountState>(accountState));
-        m_accountDB->updateAccountInfo();
+        accountDB()->updateAccountInfo();
     }
 }
 
@@ -103,13 +121,13 @@ void DAccountModule::setSyncFreq(const QString &freq)
     if (syncType == m_account->syncFreq()) {
         return;
     }
-    m_accountDB->updateAccountInfo();
+    accountDB()->updateAccountInfo();
     downloadTaskhanding(1);
 }
 
 QString DAccountModule::getScheduleTypeList()
 {
-    DScheduleType::List typeList = m_accountDB->getScheduleTypeList();
+    DScheduleType::List typeList = accountDB()->getScheduleTypeList();
     //排序
     std::sort(typeList.begin(), typeList.end());
     QString typeListStr;
@@ -119,7 +137,7 @@ QString DAccountModule::getScheduleTypeList()
 
 QString DAccountModule::getScheduleTypeByID(const QString &typeID)
 {
-    DScheduleType::Ptr scheduleType = m_accountDB->getScheduleTypeByID(typeID);
+    DScheduleType::Ptr scheduleType = accountDB()->getScheduleTypeByID(typeID);
     QString typeStr;
     DScheduleType::toJsonString(scheduleType, typeStr);
     return typeStr;
@@ -134,26 +152,26 @@ QString DAccountModule::createScheduleType(const QString &typeInfo)
         scheduleType->setColorID(DDataBase::createUuid());
         DTypeColor::Ptr typeColor(new DTypeColor(scheduleType->typeColor()));
         typeColor->setPrivilege(DTypeColor::PriUser);
-        m_accountDB->addTypeColor(typeColor);
+        accountDB()->addTypeColor(typeColor);
         //添加创建颜色任务
         if (m_account->isNetWorkAccount()) {
             DUploadTaskData::Ptr uploadTask(new DUploadTaskData);
             uploadTask->setTaskType(DUploadTaskData::TaskType::Create);
             uploadTask->setTaskObject(DUploadTaskData::Task_Color);
             uploadTask->setObjectId(typeColor->colorID());
-            m_accountDB->addUploadTask(uploadTask);
+            accountDB()->addUploadTask(uploadTask);
         }
     }
     //设置创建时间
     scheduleType->setDtCreate(QDateTime::currentDateTime());
-    QString scheduleTypeID = m_accountDB->createScheduleType(scheduleType);
+    QString scheduleTypeID = accountDB()->createScheduleType(scheduleType);
     //如果为网络日程则需要上传任务
     if (m_account->isNetWorkAccount()) {
         DUploadTaskData::Ptr uploadTask(new DUploadTaskData);
         uploadTask->setTaskType(DUploadTaskData::TaskType::Create);
         uploadTask->setTaskObject(DUploadTaskData::Task_ScheduleType);
         uploadTask->setObjectId(scheduleTypeID);
-        m_accountDB->addUploadTask(uploadTask);
+        accountDB()->addUploadTask(uploadTask);
         //开启上传任务
         uploadNetWorkAccountData();
     }
@@ -164,8 +182,8 @@ QString DAccountModule::createScheduleType(const QString &typeInfo)
 bool DAccountModule::deleteScheduleTypeByID(const QString &typeID)
 {
     //如果日程类型被使用需要删除对应到日程信息
-    if (m_accountDB->scheduleTypeByUsed(typeID)) {
-        QStringList scheduleIDList = m_accountDB->getScheduleIDListByTypeID(typeID);
+    if (accountDB()->scheduleTypeByUsed(typeID)) {
+        QStringList scheduleIDList = accountDB()->getScheduleIDListByTypeID(typeID);
         foreach (auto scheduleID, scheduleIDList) {
             closeNotification(scheduleID);
             //添加删除日程任务
@@ -174,44 +192,45 @@ bool DAccountModule::deleteScheduleTypeByID(const QString &typeID)
                 uploadTask->setTaskType(DUploadTaskData::TaskType::Delete);
                 uploadTask->setTaskObject(DUploadTaskData::Task_Schedule);
                 uploadTask->setObjectId(scheduleID);
-                m_accountDB->addUploadTask(uploadTask);
+                accountDB()->addUploadTask(uploadTask);
             }
         }
         //更新提醒任务
         updateRemindSchedules(false);
-        m_accountDB->deleteSchedulesByScheduleTypeID(typeID, !m_account->isNetWorkAccount());
+        accountDB()->deleteSchedulesByScheduleTypeID(typeID, !m_account->isNetWorkAccount());
+        scheduleChanged(QStringList(), QStringList(), scheduleIDList);
         emit signalScheduleUpdate();
     }
-    DScheduleType::Ptr scheduleType = m_accountDB->getScheduleTypeByID(typeID);
+    DScheduleType::Ptr scheduleType = accountDB()->getScheduleTypeByID(typeID);
     //根据帐户是否为网络帐户需要添加任务列表中,并设置弱删除
     if (m_account->isNetWorkAccount()) {
-        QStringList scheduleIDList = m_accountDB->getScheduleIDListByTypeID(typeID);
+        QStringList scheduleIDList = accountDB()->getScheduleIDListByTypeID(typeID);
         //弱删除
-        m_accountDB->deleteScheduleTypeByID(typeID);
+        accountDB()->deleteScheduleTypeByID(typeID);
 
         //发送操作内容给任务列表
         DUploadTaskData::Ptr uploadTask(new DUploadTaskData);
         uploadTask->setTaskType(DUploadTaskData::TaskType::Delete);
         uploadTask->setTaskObject(DUploadTaskData::Task_ScheduleType);
         uploadTask->setObjectId(typeID);
-        m_accountDB->addUploadTask(uploadTask);
+        accountDB()->addUploadTask(uploadTask);
 
         //如果颜色不为系统类型则删除
         if(scheduleType->typeColor().privilege() != DTypeColor::PriSystem){
-            m_accountDB->deleteTypeColor(scheduleType->typeColor().colorID());
+            accountDB()->deleteTypeColor(scheduleType->typeColor().colorID());
             DUploadTaskData::Ptr uploadTask(new DUploadTaskData);
             uploadTask->setTaskType(DUploadTaskData::TaskType::Delete);
             uploadTask->setTaskObject(DUploadTaskData::Task_Color);
             uploadTask->setObjectId(scheduleType->typeColor().colorID());
-            m_accountDB->addUploadTask(uploadTask);
+            accountDB()->addUploadTask(uploadTask);
         }
 
         //开启上传任务
         uploadNetWorkAccountData();
     } else {
-        m_accountDB->deleteScheduleTypeByID(typeID, 1);
+        accountDB()->deleteScheduleTypeByID(typeID, 1);
         if(scheduleType->typeColor().privilege() != DTypeColor::PriSystem){
-            m_accountDB->deleteTypeColor(scheduleType->typeColor().colorID());
+            accountDB()->deleteTypeColor(scheduleType->typeColor().colorID());
         }
     }
     if (scheduleType.isNull()) {
@@ -221,7 +240,7 @@ bool DAccountModule::deleteScheduleTypeByID(const QString &typeID)
 
     //如果为用户颜色则删除颜色
     if (scheduleType->typeColor().privilege() > 1) {
-        m_accountDB->deleteTypeColor(scheduleType->typeColor().colorID());
+        accountDB()->deleteTypeColor(scheduleType->typeColor().colorID());
     }
     emit signalScheduleTypeUpdate();
     return true;
@@ -229,34 +248,34 @@ bool DAccountModule::deleteScheduleTypeByID(const QString &typeID)
 
 bool DAccountModule::scheduleTypeByUsed(const QString &typeID)
 {
-    return m_accountDB->scheduleTypeByUsed(typeID);
+    return accountDB()->scheduleTypeByUsed(typeID);
 }
 
 bool DAccountModule::updateScheduleType(const QString &typeInfo)
 {
     DScheduleType::Ptr scheduleType;
     DScheduleType::fromJsonString(scheduleType, typeInfo);
-    DScheduleType::Ptr oldScheduleType = m_accountDB->getScheduleTypeByID(scheduleType->typeID());
+    DScheduleType::Ptr oldScheduleType = accountDB()->getScheduleTypeByID(scheduleType->typeID());
     //如果颜色有改动
     if (oldScheduleType.isNull()) {
         qCWarning(ServiceLogger) << "get oldScheduleType error,typeID:" << scheduleType->typeID();
     } else {
         if (oldScheduleType->typeColor() != scheduleType->typeColor()) {
             if (!oldScheduleType->typeColor().isSysColorInfo()) {
-                m_accountDB->deleteTypeColor(oldScheduleType->typeColor().colorID());
+                accountDB()->deleteTypeColor(oldScheduleType->typeColor().colorID());
                 //添加删除颜色任务
                 if (m_account->isNetWorkAccount()) {
                     DUploadTaskData::Ptr uploadTask(new DUploadTaskData);
                     uploadTask->setTaskType(DUploadTaskData::TaskType::Delete);
                     uploadTask->setTaskObject(DUploadTaskData::Task_Color);
                     uploadTask->setObjectId(oldScheduleType->typeColor().colorID());
-                    m_accountDB->addUploadTask(uploadTask);
+                    accountDB()->addUploadTask(uploadTask);
                 }
             }
             if (!scheduleType->typeColor().isSysColorInfo()) {
                 DTypeColor::Ptr typeColor(new DTypeColor(scheduleType->typeColor()));
                 typeColor->setPrivilege(DTypeColor::PriUser);
-                m_accountDB->addTypeColor(typeColor);
+                accountDB()->addTypeColor(typeColor);
                 scheduleType->setColorID(typeColor->colorID());
                 //添加创建颜色任务
                 if (m_account->isNetWorkAccount()) {
@@ -265,13 +284,13 @@ bool DAccountModule::updateScheduleType(const QString &typeInfo)
                     uploadTask->setTaskType(DUploadTaskData::TaskType::Create);
                     uploadTask->setTaskObject(DUploadTaskData::Task_Color);
                     uploadTask->setObjectId(typeColor->colorID());
-                    m_accountDB->addUploadTask(uploadTask);
+                    accountDB()->addUploadTask(uploadTask);
                 }
             }
         }
     }
     scheduleType->setDtUpdate(QDateTime::currentDateTime());
-    bool isSucc = m_accountDB->updateScheduleType(scheduleType);
+    bool isSucc = accountDB()->updateScheduleType(scheduleType);
 
     if (isSucc) {
         if (m_account->isNetWorkAccount()) {
@@ -279,7 +298,7 @@ bool DAccountModule::updateScheduleType(const QString &typeInfo)
             uploadTask->setTaskType(DUploadTaskData::TaskType::Modify);
             uploadTask->setTaskObject(DUploadTaskData::Task_ScheduleType);
             uploadTask->setObjectId(scheduleType->typeID());
-            m_accountDB->addUploadTask(uploadTask);
+            accountDB()->addUploadTask(uploadTask);
             //开启上传任务
             uploadNetWorkAccountData();
         }
@@ -300,14 +319,14 @@ QString DAccountModule::createSchedule(const QString &scheduleInfo)
     DSchedule::fromJsonString(schedule, scheduleInfo);
     schedule->setCreated(QDateTime::currentDateTime());
 
-    QString scheduleID = m_accountDB->createSchedule(schedule);
+    QString scheduleID = accountDB()->createSchedule(schedule);
     //根据是否为网络帐户判断是否需要更新任务列表
     if (m_account->isNetWorkAccount()) {
         DUploadTaskData::Ptr uploadTask(new DUploadTaskData);
         uploadTask->setTaskType(DUploadTaskData::TaskType::Create);
         uploadTask->setTaskObject(DUploadTaskData::Task_Schedule);
         uploadTask->setObjectId(scheduleID);
-        m_accountDB->addUploadTask(uploadTask);
+        accountDB()->addUploadTask(uploadTask);
         //开启上传任务
         uploadNetWorkAccountData();
     }
@@ -316,6 +335,7 @@ QString DAccountModule::createSchedule(const QString &scheduleInfo)
         updateRemindSchedules(false);
     }
     //发送日程更新信号
+    scheduleChanged(QStringList() << scheduleID, QStringList(), QStringList());
     emit signalScheduleUpdate();
     return scheduleID;
 }
@@ -325,14 +345,14 @@ bool DAccountModule::updateSchedule(const QString &scheduleInfo)
     //根据是否为提醒日程更新提醒任务
     DSchedule::Ptr schedule;
     DSchedule::fromJsonString(schedule, scheduleInfo);
-    DSchedule::Ptr oldSchedule = m_accountDB->getScheduleByScheduleID(schedule->uid());
+    DSchedule::Ptr oldSchedule = accountDB()->getScheduleByScheduleID(schedule->uid());
     schedule->setLastModified(QDateTime::currentDateTime());
     schedule->setRevision(schedule->revision() + 1);
 
     //如果旧日程为提醒日程
     if (oldSchedule->alarms().size() > 0) {
         //根据日程ID获取提醒日程信息
-        DRemindData::List remindList = m_accountDB->getRemindByScheduleID(schedule->schedulingID());
+        DRemindData::List remindList = accountDB()->getRemindByScheduleID(schedule->schedulingID());
 
         DRemindData::List deleteRemind;
 
@@ -367,17 +387,18 @@ bool DAccountModule::updateSchedule(const QString &scheduleInfo)
             }
         }
         for (int i = 0; i < deleteRemind.size(); ++i) {
-            m_accountDB->deleteRemindInfoByAlarmID(deleteRemind.at(i)->alarmID());
+            accountDB()->deleteRemindInfoByAlarmID(deleteRemind.at(i)->alarmID());
         }
     }
 
-    bool ok = m_accountDB->updateSchedule(schedule);
+    bool ok = accountDB()->updateSchedule(schedule);
 
     //如果存在提醒
     if (oldSchedule->alarms().size() > 0 || schedule->alarms().size() > 0) {
         updateRemindSchedules(false);
     }
 
+    scheduleChanged(QStringList(), QStringList() << schedule->uid(), QStringList());
     emit signalScheduleUpdate();
     //根据是否为网络帐户判断是否需要更新任务列表
     if (m_account->isNetWorkAccount()) {
@@ -385,7 +406,7 @@ bool DAccountModule::updateSchedule(const QString &scheduleInfo)
         uploadTask->setTaskType(DUploadTaskData::TaskType::Modify);
         uploadTask->setTaskObject(DUploadTaskData::Task_Schedule);
         uploadTask->setObjectId(schedule->uid());
-        m_accountDB->addUploadTask(uploadTask);
+        accountDB()->addUploadTask(uploadTask);
         //开启上传任务
         uploadNetWorkAccountData();
     }
@@ -394,7 +415,7 @@ bool DAccountModule::updateSchedule(const QString &scheduleInfo)
 
 QString DAccountModule::getScheduleByScheduleID(const QString &scheduleID)
 {
-    DSchedule::Ptr schedule = m_accountDB->getScheduleByScheduleID(scheduleID);
+    DSchedule::Ptr schedule = accountDB()->getScheduleByScheduleID(scheduleID);
     QString scheduleStr;
     DSchedule::toJsonString(schedule, scheduleStr);
     return scheduleStr;
@@ -404,19 +425,19 @@ bool DAccountModule::deleteScheduleByScheduleID(const QString &scheduleID)
 {
     //根据是否为网络判断是否需要弱删除
     bool isOK;
-    DSchedule::Ptr schedule = m_accountDB->getScheduleByScheduleID(scheduleID);
+    DSchedule::Ptr schedule = accountDB()->getScheduleByScheduleID(scheduleID);
     if (m_account->isNetWorkAccount()) {
-        isOK = m_accountDB->deleteScheduleByScheduleID(scheduleID);
+        isOK = accountDB()->deleteScheduleByScheduleID(scheduleID);
         //更新上传任务表
         DUploadTaskData::Ptr uploadTask(new DUploadTaskData);
         uploadTask->setTaskType(DUploadTaskData::TaskType::Delete);
         uploadTask->setTaskObject(DUploadTaskData::Task_Schedule);
         uploadTask->setObjectId(scheduleID);
-        m_accountDB->addUploadTask(uploadTask);
+        accountDB()->addUploadTask(uploadTask);
         //开启任务
         uploadNetWorkAccountData();
     } else {
-        isOK = m_accountDB->deleteScheduleByScheduleID(scheduleID, 1);
+        isOK = accountDB()->deleteScheduleByScheduleID(scheduleID, 1);
     }
     //如果删除的是提醒日程
     if (schedule->alarms().size() > 0) {
@@ -424,27 +445,66 @@ bool DAccountModule::deleteScheduleByScheduleID(const QString &scheduleID)
         closeNotification(scheduleID);
         updateRemindSchedules(false);
     }
+    scheduleChanged(QStringList(), QStringList(), QStringList() << scheduleID);
     emit signalScheduleUpdate();
     return isOK;
 }
 
 QString DAccountModule::querySchedulesWithParameter(const QString &params)
 {
-    DScheduleQueryPar::Ptr queryPar = DScheduleQueryPar::fromJsonString(params);
-    if (queryPar.isNull()) {
+    DSchedule::List scheduleList;
+    if (!querySchedules(DScheduleQueryPar::fromJsonString(params), scheduleList)) {
         return QString();
     }
+    return DSchedule::toListString(params, scheduleList);
+}
+
+QByteArray DAccountModule::querySchedulesWithParameterV2(const QString &params)
+{
+    DSchedule::List scheduleList;
+    if (!querySchedules(DScheduleQueryPar::fromJsonString(params), scheduleList)) {
+        return QByteArray();
+    }
+    return DSchedule::toListBinary(params, scheduleList);
+}
+
+QByteArray DAccountModule::queryScheduleOccurrences(const QString &params, const int offset, const int limit)
+{
+    DScheduleQueryPar::Ptr queryPar = DScheduleQueryPar::fromJsonString(params);
     DSchedule::List scheduleList;
+    if (!querySchedules(queryPar, scheduleList)) {
+        return QByteArray();
+    }
+    //实例只保存原日程和本次重复的时间，传输时原日程只保存一次
+    DScheduleOccurrence::List occurrences = DScheduleOccurrence::expand(scheduleList, queryPar->dtStart(), queryPar->dtEnd());
+    //按开始时间排序后分页
+    std::stable_sort(occurrences.begin(), occurrences.end(), [](const DScheduleOccurrence &o1, const DScheduleOccurrence &o2) {
+        return o1.dtStart() < o2.dtStart();
+    });
+    if (offset > 0 || limit > 0) {
+        int begin = qBound(0, offset, occurrences.size());
+        int count = limit > 0 ? qMin(limit, occurrences.size() - begin) : occurrences.size() - begin;
+        occurrences = occurrences.mid(begin, count);
+    }
+    return DScheduleOccurrence::toListBinary(params, occurrences);
+}
+
+bool DAccountModule::querySchedules(const DScheduleQueryPar::Ptr &queryPar, DSchedule::List &scheduleList)
+{
+    if (queryPar.isNull()) {
+        return false;
+    }
     if (queryPar->queryType() == DScheduleQueryPar::Query_RRule) {
-        scheduleList = m_accountDB->querySchedulesByRRule(queryPar->key(), queryPar->rruleType());
+        scheduleList = accountDB()->querySchedulesByRRule(queryPar->key(), queryPar->rruleType());
     } else if (queryPar->queryType() == DScheduleQueryPar::Query_ScheduleID) {
-        DSchedule::Ptr schedule = m_accountDB->getScheduleByScheduleID(queryPar->key());
+        DSchedule::Ptr schedule = accountDB()->getScheduleByScheduleID(queryPar->key());
         if (schedule.isNull()) {
-            return QString();
+            return false;
         }
         scheduleList.append(schedule);
     } else {
-        scheduleList = m_accountDB->querySchedulesByKey(queryPar->key());
+        //客户端只展示查询范围内的日程，将时间范围下推到数据库查询
+        scheduleList = accountDB()->querySchedulesByKey(queryPar->key(), queryPar->dtStart(), queryPar->dtEnd());
     }
 
     bool extend = queryPar->queryType() == DScheduleQueryPar::Query_None;
@@ -452,31 +512,31 @@ QString DAccountModule::querySchedulesWithParameter(const QString &params)
     if (isChineseEnv() && extend && m_account->accountType() == DAccount::Account_Local) {
         scheduleList.append(getFestivalSchedule(queryPar->dtStart(), queryPar->dtEnd(), queryPar->key()));
     }
-
-    return DSchedule::toListString(params, scheduleList);
+    return true;
 }
 
 DSchedule::List DAccountModule::getRemindScheduleList(const QDateTime &dtStart, const QDateTime &dtEnd)
 {
     //获取范围内需要提醒的日程信息
     DSchedule::List scheduleList;
+    //只读取下一次提醒时间在结束时间之前的日程
+    DSchedule::List remindSchedules = accountDB()->getRemindSchedule(dtEnd);
     //当前最多提前一周提醒。所以结束时间+8天
-    QMap<QDate, DSchedule::List> scheduleMap = getScheduleTimesOn(dtStart, dtEnd.addDays(8), m_accountDB->getRemindSchedule(), false);
-    QMap<QDate, DSchedule::List>::const_iterator iter = scheduleMap.constBegin();
-    for (; iter != scheduleMap.constEnd(); ++iter) {
-        foreach (auto schedule, iter.value()) {
-            if (schedule->alarms().size() > 0
-                    && schedule->alarms()[0]->time() >= dtStart && schedule->alarms()[0]->time() <= dtEnd) {
-                scheduleList.append(schedule);
-            }
+    DSchedule::List occurrences = DSchedule::expandOccurrences(remindSchedules, dtStart, dtEnd.addDays(8));
+    foreach (auto schedule, occurrences) {
+        if (schedule->alarms().size() > 0
+                && schedule->alarms()[0]->time() >= dtStart && schedule->alarms()[0]->time() <= dtEnd) {
+            scheduleList.append(schedule);
         }
     }
+    //以开始时间为起点更新下一次提醒时间，之后的查询开始时间不会早于该起点
+    accountDB()->updateNextAlarm(remindSchedules, dtStart);
     return scheduleList;
 }
 
 QString DAccountModule::getSysColors()
 {
-    DTypeColor::List colorList = m_accountDB->getSysColor();
+    DTypeColor::List colorList = accountDB()->getSysColor();
     std::sort(colorList.begin(), colorList.end());
     return DTypeColor::toJsonString(colorList);
 }
@@ -494,7 +554,12 @@ void DAccountModule::updateRemindSchedules(bool isClear)
     QDateTime dtEnd = dtCurrent.addMSecs(UPDATEREMINDJOBTIMEINTERVAL);
 
     //获取未提醒的日程相关信息
-    DRemindData::List noRemindList = m_accountDB->getValidRemindJob();
+    DRemindData::List noRemindList = accountDB()->getValidRemindJob();
+
+    //清空时重新计算所有日程的下一次提醒时间，避免系统时间回调后遗漏提醒
+    if (isClear) {
+        accountDB()->refreshScheduleAlarm(true);
+    }
 
     //获取每个账户下需要提醒的日程信息
     DRemindData::List accountRemind;
@@ -529,24 +594,24 @@ void DAccountModule::updateRemindSchedules(bool isClear)
 
     if (isClear) {
         //清空数据库
-        m_accountDB->clearRemindJobDatabase();
+        accountDB()->clearRemindJobDatabase();
 
         foreach (auto remind, noRemindList) {
-            m_accountDB->createRemindInfo(remind);
+            accountDB()->createRemindInfo(remind);
         }
     }
     //添加从账户中获取到的需要提醒的日程信息
     foreach (auto remind, accountRemind) {
-        m_accountDB->createRemindInfo(remind);
+        accountDB()->createRemindInfo(remind);
     }
     accountRemind.append(noRemindList);
     //更新提醒任务
-    m_alarm->updateRemind(accountRemind);
+    m_alarm->updateRemind(m_account->accountID(), accountRemind);
 }
 
 void DAccountModule::notifyMsgHanding(const QString &alarmID, const qint32 operationNum)
 {
-    DRemindData::Ptr remindData = m_accountDB->getRemindData(alarmID);
+    DRemindData::Ptr remindData = accountDB()->getRemindData(alarmID);
     remindData->setAccountID(m_account->accountID());
     //如果相应的日程被删除,则不做处理
     if (remindData.isNull()) {
@@ -559,23 +624,23 @@ void DAccountModule::notifyMsgHanding(const QString &alarmID, const qint32 opera
     case 2: { //稍后提醒
         remindData->setRemindCount(remindData->remindCount() + 1);
         remindData->updateRemindTimeByCount();
-        m_accountDB->updateRemindInfo(remindData);
+        accountDB()->updateRemindInfo(remindData);
     } break;
     case 21: { //15min后提醒
         remindData->updateRemindTimeByMesc(15 * Minute);
-        m_accountDB->updateRemindInfo(remindData);
+        accountDB()->updateRemindInfo(remindData);
     } break;
     case 22: { //一个小时后提醒
         remindData->updateRemindTimeByMesc(Hour);
-        m_accountDB->updateRemindInfo(remindData);
+        accountDB()->updateRemindInfo(remindData);
     } break;
     case 23: { //四个小时后提醒
         remindData->updateRemindTimeByMesc(4 * Hour);
-        m_accountDB->updateRemindInfo(remindData);
+        accountDB()->updateRemindInfo(remindData);
     } break;
     case 3: { //明天提醒
         remindData->updateRemindTimeByMesc(24 * Hour);
-        m_accountDB->updateRemindInfo(remindData);
+        accountDB()->updateRemindInfo(remindData);
     } break;
     case 1: { //打开日历
     } break;
@@ -587,14 +652,15 @@ void DAccountModule::notifyMsgHanding(const QString &alarmID, const qint32 opera
         } else {
             schedule->setAlarmType(DSchedule::Alarm_1Day_Front);
         }
-        m_accountDB->updateSchedule(schedule);
+        accountDB()->updateSchedule(schedule);
         //删除对应提醒任务数据
-        m_accountDB->deleteRemindInfoByAlarmID(alarmID);
+        accountDB()->deleteRemindInfoByAlarmID(alarmID);
+        scheduleChanged(QStringList(), QStringList() << schedule->uid(), QStringList());
         emit signalScheduleUpdate();
     } break;
     default:
         //删除对应提醒任务数据
-        m_accountDB->deleteRemindInfoByAlarmID(alarmID);
+        accountDB()->deleteRemindInfoByAlarmID(alarmID);
         break;
     }
 
@@ -603,13 +669,13 @@ void DAccountModule::notifyMsgHanding(const QString &alarmID, const qint32 opera
 
 void DAccountModule::remindJob(const QString &alarmID)
 {
-    DRemindData::Ptr remindData = m_accountDB->getRemindData(alarmID);
+    DRemindData::Ptr remindData = accountDB()->getRemindData(alarmID);
     remindData->setAccountID(m_account->accountID());
     DSchedule::Ptr schedule = getScheduleByRemind(remindData);
 
     int notifyid = m_alarm->remindJob(remindData, schedule);
     remindData->setNotifyid(notifyid);
-    m_accountDB->updateRemindInfo(remindData);
+    accountDB()->updateRemindInfo(remindData);
 }
 
 void DAccountModule::accountDownload()
@@ -633,8 +699,17 @@ QString DAccountModule::getDtLastUpdate()
     return dtToString(m_account->dtLastSync());
 }
 
+QString DAccountModule::getScheduleCacheStatistics()
+{
+    QJsonObject rootObj = QJsonDocument::fromJson(m_scheduleCache->toJsonString().toUtf8()).object();
+    //重复日程实例时间缓存为进程内共享，所有帐户的统计信息相同
+    rootObj.insert("occurrences", DOccurrenceCache::instance()->toJsonObject());
+    return QString::fromUtf8(QJsonDocument(rootObj).toJson(QJsonDocument::Compact));
+}
+
 void DAccountModule::removeDB()
 {
+    m_scheduleCache->clear();
     m_accountDB->removeDB();
     //如果为uid帐户退出则清空目录下所有关于uid的数据库文件
     //解决在某些条件下数据库没有被移除的问题（自测未发现）
@@ -653,90 +728,6 @@ void DAccountModule::removeDB()
     }
 }
 
-QMap<QDate, DSchedule::List> DAccountModule::getScheduleTimesOn(const QDateTime &dtStart, const QDateTime &dtEnd, const DSchedule::List &scheduleList, bool extend)
-{
-    QMap<QDate, DSchedule::List> m_scheduleMap;
-    //相差多少天
-    int days = static_cast<int>(dtStart.daysTo(dtEnd));
-    for (int i = 0; i <= days; ++i) {
-        DSchedule::List scheduleList;
-        m_scheduleMap[dtStart.addDays(i).date()] = scheduleList;
-    }
-
-    foreach (auto &schedule, scheduleList) {
-        //获取日程的开始结束时间差
-        qint64 interval = schedule->dtStart().secsTo(schedule->dtEnd());
-        //如果存在重复日程
-        if (schedule->recurs()) {
-            //如果为农历日程
-            if (schedule->lunnar()) {
-                //农历重复日程计算
-                LunarDateInfo lunardate(schedule->recurrence()->defaultRRuleConst(), interval);
-
-                QMap<int, QDate> ruleStartDate = lunardate.getRRuleStartDate(dtStart.date(), dtEnd.date(), schedule->dtStart().date());
-
-                QDateTime recurDateTime;
-                recurDateTime.setTime(schedule->dtStart().time());
-                QDateTime copyEnd;
-                QMap<int, QDate>::ConstIterator iter = ruleStartDate.constBegin();
-                for (; iter != ruleStartDate.constEnd(); iter++) {
-                    recurDateTime.setDate(iter.value());
-                    //如果在忽略时间列表中,则忽略
-                    if (schedule->recurrence()->exDateTimes().contains(recurDateTime))
-                        continue;
-                    copyEnd = recurDateTime.addSecs(interval);
-                    DSchedule::Ptr newSchedule = DSchedule::Ptr(new DSchedule(*schedule.data()));
-                    newSchedule->setDtStart(recurDateTime);
-                    newSchedule->setDtEnd(copyEnd);
-                    //只有重复日程设置RecurrenceId
-                    if (schedule->dtStart() != recurDateTime) {
-                        newSchedule->setRecurrenceId(recurDateTime);
-                    }
-
-                    if (extend) {
-                        //需要扩展的天数
-                        int extenddays = static_cast<int>(recurDateTime.daysTo(copyEnd));
-                        for (int i = 0; i <= extenddays; ++i) {
-                            m_scheduleMap[recurDateTime.date().addDays(i)].append(newSchedule);
-                        }
-
-                    } else {
-                        m_scheduleMap[recurDateTime.date()].append(newSchedule);
-                    }
-                }
-            } else {
-                //非农历日程
-                extendRecurrence(m_scheduleMap, schedule, dtStart, dtEnd, extend);
-            }
-        } else {
-            //普通日程
-            //如果在查询时间范围内
-            QDateTime queryDtStart = dtStart;
-            //如果日程为全天日程，则查询的开始时间设置为0点，因为全天日程的开始和结束时间都是0点
-            if(schedule->allDay()){
-                queryDtStart.setTime(QTime(0,0,0));
-            }
-            if (!(schedule->dtEnd() < queryDtStart || schedule->dtStart() > dtEnd)) {
-                if (extend && schedule->isMultiDay()) {
-                    //需要扩展的天数
-                    int extenddays = static_cast<int>(schedule->dtStart().daysTo(schedule->dtEnd()));
-                    for (int i = 0; i <= extenddays; ++i) {
-                        //如果扩展的日期在查询范围内则添加，否则退出
-                        if(m_scheduleMap.contains(schedule->dtStart().date().addDays(i))){
-                            m_scheduleMap[schedule->dtStart().date().addDays(i)].append(schedule);
-                        } else {
-                            break;
-                        }
-                    }
-                } else {
-                    m_scheduleMap[schedule->dtStart().date()].append(schedule);
-                }
-            }
-        }
-    }
-    return m_scheduleMap;
-}
-
 DSchedule::List DAccountModule::getFestivalSchedule(const QDateTime &dtStart, const QDateTime &dtEnd, const QString &key)
 {
     QList<stDayFestival> festivaldays = GetFestivalsInRange(dtStart, dtEnd);
@@ -754,7 +745,7 @@ DSchedule::List DAccountModule::getFestivalSchedule(const QDateTime &dtStart, co
                 schedule->setDtEnd(QDateTime(QDate(festivalDay.date.date()), QTime(23, 59)));
                 //设置UID为开始时间+内容
                 schedule->setUid(dtToString(schedule->dtStart()) + schedule->summary());
-                schedule->setScheduleTypeID(m_accountDB->getFestivalTypeID());
+                schedule->setScheduleTypeID(accountDB()->getFestivalTypeID());
                 scheduleList.append(schedule);
             }
         }
@@ -762,57 +753,27 @@ DSchedule::List DAccountModule::getFestivalSchedule(const QDateTime &dtStart, co
     return scheduleList;
 }
 
-void DAccountModule::extendRecurrence(DSchedule::Map &scheduleMap, const DSchedule::Ptr &schedule, const QDateTime &dtStart, const QDateTime &dtEnd, bool extend)
-{
-    QDateTime queryDtStart = dtStart;
-    //如果日程为全天日程，则查询的开始时间设置为0点，因为全天日程的开始和结束时间都是0点
-    if(schedule->allDay()){
-        queryDtStart.setTime(QTime(0,0,0));
-    }
-    if (schedule->recurs()) {
-        //获取日程的开始结束时间差
-        qint64 interval = schedule->dtStart().secsTo(schedule->dtEnd());
-        QList<QDateTime> dtList = schedule->recurrence()->timesInInterval(queryDtStart, dtEnd);
-        foreach (auto &dt, dtList) {
-            QDateTime scheduleDtEnd = dt.addSecs(interval);
-            DSchedule::Ptr newSchedule = DSchedule::Ptr(schedule->clone());
-            newSchedule->setDtStart(dt);
-            newSchedule->setDtEnd(scheduleDtEnd);
-
-            //只有重复日程设置RecurrenceId
-            if (schedule->dtStart() != dt) {
-                newSchedule->setRecurrenceId(dt);
-            }
-            if (extend) {
-                //需要扩展的天数
-                int extenddays = static_cast<int>(dt.daysTo(scheduleDtEnd));
-                for (int i = 0; i <= extenddays; ++i) {
-                    scheduleMap[dt.date().addDays(i)].append(newSchedule);
-                }
-            } else {
-                scheduleMap[dt.date()].append(newSchedule);
-            }
-        }
-    } else {
-        if (!(schedule->dtStart() > dtEnd || schedule->dtEnd() < queryDtStart)) {
-            scheduleMap[schedule->dtStart().date()].append(schedule);
-        }
-    }
-}
-
 void DAccountModule::closeNotification(const QString &scheduleId)
 {
     //根据日程ID获取提醒日程信息
-    DRemindData::List remindList = m_accountDB->getRemindByScheduleID(scheduleId);
+    DRemindData::List remindList = accountDB()->getRemindByScheduleID(scheduleId);
     foreach (auto remind, remindList) {
-        m_accountDB->deleteRemindInfoByAlarmID(remind->alarmID());
+        accountDB()->deleteRemindInfoByAlarmID(remind->alarmID());
         emit signalCloseNotification(static_cast<quint32>(remind->notifyid()));
     }
 }
 
+void DAccountModule::scheduleChanged(const QStringList &insertedIDs, const QStringList &updatedIDs, const QStringList &deletedIDs)
+{
+    foreach (auto scheduleID, updatedIDs + deletedIDs) {
+        m_scheduleCache->remove(scheduleID);
+    }
+    emit signalScheduleChanged(insertedIDs, updatedIDs, deletedIDs);
+}
+
 DSchedule::Ptr DAccountModule::getScheduleByRemind(const DRemindData::Ptr &remindData)
 {
-    DSchedule::Ptr schedule = m_accountDB->getScheduleByScheduleID(remindData->scheduleID());
+    DSchedule::Ptr schedule = accountDB()->getScheduleByScheduleID(remindData->scheduleID());
     if (!schedule.isNull() && schedule->dtStart() != remindData->dtStart()) {
         schedule->setDtStart(remindData->dtStart());
         schedule->setDtEnd(remindData->dtEnd());
@@ -877,7 +838,7 @@ void DAccountModule::slotOpenCalendar(const QString &alarmID)
                                     "/com/deepin/Calendar",
                                     QDBusConnection::sessionBus(),
                                     this);
-    DRemindData::Ptr remindData = m_accountDB->getRemindData(alarmID);
+    DRemindData::Ptr remindData = accountDB()->getRemindData(alarmID);
     if (remindData.isNull()) {
         qCWarning(ServiceLogger) << "No corresponding reminder ID found";
         return;
@@ -887,7 +848,7 @@ void DAccountModule::slotOpenCalendar(const QString &alarmID)
     DSchedule::toJsonString(schedule, scheduleStr);
     openCalendar.OpenSchedule(scheduleStr);
     //删除对应提醒任务数据
-    m_accountDB->deleteRemindInfoByAlarmID(alarmID);
+    accountDB()->deleteRemindInfoByAlarmID(alarmID);
 }
 
 void DAccountModule::slotSyncState(const int syncState)
@@ -897,7 +858,7 @@ void DAccountModule::slotSyncState(const int syncState)
     case 0:
         //执行正常
         m_account->setSyncState(DAccount::Sync_Normal);
-        m_accountDB->updateAccountInfo();
+        accountDB()->updateAccountInfo();
         //同步成功后更新提醒任务
         updateRemindSchedules(false);
         break;
@@ -934,6 +895,9 @@ void DAccountModule::slotDateUpdate(const DDataSyncBase::UpdateTypes updateType)
         emit signalSettingChange();
     }
     if (updateType.testFlag(DDataSyncBase::Update_Schedule)) {
+        //云同步修改了日程数据，需要补全日程有效时间范围和下一次提醒时间，日程缓存已根据变化的日程ID清理
+        accountDB()->refreshScheduleSpan();
+        accountDB()->refreshScheduleAlarm();
         emit signalScheduleUpdate();
     }
     if (updateType.testFlag(DDataSyncBase::Update_ScheduleType)) {
@@ -944,30 +908,142 @@ void DAccountModule::slotDateUpdate(const DDataSyncBase::UpdateTypes updateType)
 // 导入日程
 bool DAccountModule::importSchedule(const QString &icsFilePath, const QString &typeID, const bool cleanExists)
 {
-    KCalendarCore::ICalFormat icalformat;
-    QTimeZone timezone = QDateTime::currentDateTime().timeZone();
-    KCalendarCore::MemoryCalendar::Ptr cal(new KCalendarCore::MemoryCalendar(timezone));
-    auto ok = icalformat.load(cal, icsFilePath);
-    if (!ok) {
+    QFile file(icsFilePath);
+    if (!file.open(QIODevice::ReadOnly | QIODevice::Text)) {
         qCWarning(ServiceLogger) << "can not load ics file from" << icsFilePath;
         return false;
     }
-    auto events = cal->events();
+    QStringList insertedIDs;
+    QStringList deletedIDs;
+    //清理原有日程和所有批次的写入在同一个事务中，任何一步失败时回滚，不会丢失原有日程或只导入部分日程
+    accountDB()->transaction();
+    bool ok = true;
     if (cleanExists) {
-        ok = m_accountDB->deleteSchedulesByScheduleTypeID(typeID, true);
-        if (!ok) {
+        deletedIDs = accountDB()->getScheduleIDListByTypeID(typeID);
+        if (!accountDB()->deleteSchedulesByScheduleTypeID(typeID, true)) {
             qCWarning(ServiceLogger) << "can not clean schedules from" << typeID;
-            return false;
+            ok = false;
         }
     };
-    foreach (auto event, events) {
-        auto data = event.data();
-        auto sch = DSchedule::Ptr(new DSchedule(*data));
-        sch->setScheduleTypeID(typeID);
-        qCInfo(ServiceLogger) << "import schedule" << event.data()->dtStart().toString()
-                << event.data()->summary() << m_accountDB->createSchedule(sch);
+
+    //逐行读取文件，按批次解析VEVENT并写入数据库，避免一次性加载整个文件
+    QTextStream stream(&file);
+    stream.setCodec("UTF-8");
+    QString calendarProperties; //日历属性
+    QString timezones;          //时区信息
+    QString events;             //当前批次的日程
+    QString component;          //当前所在的组件名称
+    int depth = 0;
+    int eventCount = 0;
+    int importCount = 0;
+    bool hasCalendar = false;
+    bool inCalendar = false;
+    auto importEvents = [&]() {
+        if (eventCount == 0) {
+            return;
+        }
+        QString icsStr = "BEGIN:VCALENDAR\r\n" + calendarProperties + timezones + events + "END:VCALENDAR\r\n";
+        KCalendarCore::ICalFormat icalformat;
+        KCalendarCore::MemoryCalendar::Ptr cal(new KCalendarCore::MemoryCalendar(QDateTime::currentDateTime().timeZone()));
+        if (icalformat.fromString(cal, icsStr)) {
+            DSchedule::List scheduleList;
+            foreach (auto event, cal->events()) {
+                auto sch = DSchedule::Ptr(new DSchedule(*event.data()));
+                sch->setScheduleTypeID(typeID);
+                scheduleList.append(sch);
+            }
+            const int count = accountDB()->createSchedules(scheduleList);
+            if (count != scheduleList.size()) {
+                qCWarning(ServiceLogger) << "can not write schedules from" << icsFilePath;
+                ok = false;
+            }
+            importCount += count;
+            foreach (auto schedule, scheduleList) {
+                //写入失败的日程ID为空
+                if (!schedule->uid().isEmpty()) {
+                    insertedIDs.append(schedule->uid());
+                }
+            }
+        } else {
+            qCWarning(ServiceLogger) << "can not parse schedules from" << icsFilePath;
+            ok = false;
+        }
+        events.clear();
+        eventCount = 0;
+        emit signalImportProgress(importCount, file.size() > 0 ? static_cast<int>(file.pos() * 100 / file.size()) : 100);
     };
+
+    //其它程序导出的文件中时区可能位于日程之后，先读取所有时区，保证每个批次的日程都能找到时区定义
+    int timezoneDepth = 0;
+    while (!stream.atEnd()) {
+        const QString line = stream.readLine();
+        if (timezoneDepth == 0 && !line.startsWith("BEGIN:VTIMEZONE", Qt::CaseInsensitive)) {
+            continue;
+        }
+        if (line.startsWith("BEGIN:", Qt::CaseInsensitive)) {
+            ++timezoneDepth;
+        } else if (line.startsWith("END:", Qt::CaseInsensitive)) {
+            --timezoneDepth;
+        }
+        timezones += line + "\r\n";
+    }
+    stream.seek(0);
+
+    while (ok && !stream.atEnd()) {
+        QString line = stream.readLine();
+        if (depth == 0) {
+            if (line.startsWith("BEGIN:VCALENDAR", Qt::CaseInsensitive)) {
+                hasCalendar = true;
+                inCalendar = true;
+                continue;
+            } else if (line.startsWith("END:VCALENDAR", Qt::CaseInsensitive)) {
+                inCalendar = false;
+                continue;
+            } else if (!inCalendar) {
+                //VCALENDAR之外的内容不导入
+                continue;
+            } else if (line.startsWith("BEGIN:", Qt::CaseInsensitive)) {
+                component = line.mid(6).trimmed().toUpper();
+                depth = 1;
+            } else {
+                calendarProperties += line + "\r\n";
+                continue;
+            }
+        } else if (line.startsWith("BEGIN:", Qt::CaseInsensitive)) {
+            ++depth;
+        } else if (line.startsWith("END:", Qt::CaseInsensitive)) {
+            --depth;
+        }
+        //只处理日程，时区已经读取，其它组件忽略
+        if (component == "VEVENT") {
+            events += line + "\r\n";
+            if (depth == 0) {
+                ++eventCount;
+                if (eventCount >= ImportBatchSize) {
+                    importEvents();
+                }
+            }
+        }
+        if (depth == 0) {
+            component.clear();
+        }
+    }
+    if (ok) {
+        importEvents();
+    }
+    file.close();
+    if (!hasCalendar) {
+        qCWarning(ServiceLogger) << "can not load ics file from" << icsFilePath;
+        ok = false;
+    }
+    if (!ok) {
+        accountDB()->rollback();
+        return false;
+    }
+    accountDB()->commit();
+    qCInfo(ServiceLogger) << "import" << importCount << "schedules from" << icsFilePath;
     // 发送日程更新信号
+    scheduleChanged(insertedIDs, QStringList(), deletedIDs);
     emit signalScheduleUpdate();
     return true;
 }
@@ -975,19 +1051,30 @@ bool DAccountModule::importSchedule(const QString &icsFilePath, const QString &t
 // 导出日程
 bool DAccountModule::exportSchedule(const QString &icsFilePath, const QString &typeID)
 {
-    auto typeInfo = m_accountDB->getScheduleTypeByID(typeID);
-    KCalendarCore::MemoryCalendar::Ptr cal(new KCalendarCore::MemoryCalendar(nullptr));
-    // 附加扩展信息
-    cal->setNonKDECustomProperty("X-DDE-CALENDAR-TYPE-ID", typeID);
-    cal->setNonKDECustomProperty("X-DDE-CALENDAR-TYPE-NAME", typeInfo->displayName());
-    cal->setNonKDECustomProperty("X-DDE-CALENDAR-TYPE-COLOR", typeInfo->getColorCode());
-    cal->setNonKDECustomProperty("X-WR-CALNAME", typeInfo->displayName());
-
-    auto ids = m_accountDB->getScheduleIDListByTypeID(typeID);
-    foreach (auto id, ids) {
-        auto schedule = m_accountDB->getScheduleByScheduleID(id);
-        cal->addEvent(schedule);
-    }
-    KCalendarCore::ICalFormat icalformat;
-    return icalformat.save(cal, icsFilePath);
+    auto typeInfo = accountDB()->getScheduleTypeByID(typeID);
+    if (typeInfo.isNull()) {
+        qCWarning(ServiceLogger) << "can not find schedule type" << typeID;
+        return false;
+    }
+    QFile file(icsFilePath);
+    if (!file.open(QIODevice::WriteOnly | QIODevice::Truncate)) {
+        qCWarning(ServiceLogger) << "can not open ics file" << icsFilePath;
+        return false;
+    }
+    QTextStream stream(&file);
+    stream.setCodec("UTF-8");
+    stream << "BEGIN:VCALENDAR\r\n"
+           << "PRODID:" << KCalendarCore::CalFormat::productId() << "\r\n"
+           << "VERSION:2.0\r\n";
+    // 附加扩展信息，类型名称等内容需要转义和折行
+    stream << icsTextProperty("X-DDE-CALENDAR-TYPE-ID", typeID)
+           << icsTextProperty("X-DDE-CALENDAR-TYPE-NAME", typeInfo->displayName())
+           << icsTextProperty("X-DDE-CALENDAR-TYPE-COLOR", typeInfo->getColorCode())
+           << icsTextProperty("X-WR-CALNAME", typeInfo->displayName());
+    //直接写入数据库中保存的日程数据
+    bool ok = accountDB()->exportSchedulesByTypeID(typeID, stream);
+    stream << "END:VCALENDAR\r\n";
+    stream.flush();
+    file.close();
+    return ok && stream.status() == QTextStream::Ok;
 }
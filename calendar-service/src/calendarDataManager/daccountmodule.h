@@ -9,6 +9,7 @@
 #include "daccountdatabase.h"
 #include "dschedule.h"
 #include "dalarmmanager.h"
+#include "dschedulecache.h"
 #include "ddatasyncbase.h"
 #include "icalformat.h"
 #include "memorycalendar.h"
@@ -54,6 +55,13 @@ public:
     QString getScheduleByScheduleID(const QString &scheduleID);
     bool deleteScheduleByScheduleID(const QString &scheduleID);
     QString querySchedulesWithParameter(const QString &params);
+    QByteArray querySchedulesWithParameterV2(const QString &params);
+    /**
+     * @brief queryScheduleOccurrences      根据查询参数获取范围内展开后的日程实例
+     * @param offset                        分页偏移
+     * @param limit                         分页数量，小于等于0时返回全部
+     */
+    QByteArray queryScheduleOccurrences(const QString &params, const int offset, const int limit);
 
     bool exportSchedule(const QString &icsFilePath, const QString &typeID);                         // 导出ICS文件
     bool importSchedule(const QString &icsFilePath, const QString &typeID, const bool cleanExists); // 导入ICS文件
@@ -98,24 +106,34 @@ public:
     //获取最后一次同步时间
     QString getDtLastUpdate();
 
+    //获取日程缓存统计信息
+    QString getScheduleCacheStatistics();
+
 private:
-    QMap<QDate, DSchedule::List> getScheduleTimesOn(const QDateTime &dtStart, const QDateTime &dtEnd, const DSchedule::List &scheduleList, bool extend = true);
+    //获取帐户数据库，第一次获取时补全旧版本数据库
+    DAccountDataBase::Ptr accountDB();
+    //根据查询参数获取日程，查询参数无效时返回false
+    bool querySchedules(const DScheduleQueryPar::Ptr &queryPar, DSchedule::List &scheduleList);
     DSchedule::List getFestivalSchedule(const QDateTime &dtStart, const QDateTime &dtEnd, const QString &key);
 
-    //根据重复规则扩展非农历重复日程
-    void extendRecurrence(DSchedule::Map &scheduleMap, const DSchedule::Ptr &schedule, const QDateTime &dtStart, const QDateTime &dtEnd, bool extend = true);
-
     /**
      * @brief closeNotification     关闭通知弹框
      * @param scheduleId            日程id
      */
     void closeNotification(const QString &scheduleId);
 
+    /**
+     * @brief scheduleChanged       日程数据发生变化，清理对应的缓存并发送变化的日程ID
+     */
+    void scheduleChanged(const QStringList &insertedIDs, const QStringList &updatedIDs, const QStringList &deletedIDs);
+
     //根据提醒任务获取对应的日程信息
     DSchedule::Ptr getScheduleByRemind(const DRemindData::Ptr &remindData);
 
 signals:
     void signalScheduleUpdate();
+    //日程数据发生变化，参数分别为新增、修改、删除的日程ID，在signalScheduleUpdate之前发送
+    void signalScheduleChanged(const QStringList &insertedIDs, const QStringList &updatedIDs, const QStringList &deletedIDs);
     void signalScheduleTypeUpdate();
     //关闭通知弹框
     void signalCloseNotification(quint64 notifyID);
@@ -130,6 +148,9 @@ signals:
     //数据同步完成
     void signalSyncFinished(int);
 
+    //导入日程进度，count为已导入的日程数量，percent为文件读取进度
+    void signalImportProgress(int count, int percent);
+
 public slots:
     void slotOpenCalendar(const QString &alarmID);
 
@@ -139,6 +160,7 @@ public slots:
 private:
     DAccount::Ptr m_account;
     DAccountDataBase::Ptr m_accountDB;
+    DScheduleCache::Ptr m_scheduleCache;
     DAlarmManager::Ptr m_alarm;
     DDataSyncBase *m_dataSync;
 };
@@ -0,0 +1,78 @@
+// SPDX-FileCopyrightText: 2019 - 2022 UnionTech Software Technology Co., Ltd.
+//
+// SPDX-License-Identifier: LGPL-3.0-or-later
+
+#include "dschedulecache.h"
+
+#include <QJsonDocument>
+#include <QJsonObject>
+#include <QMutexLocker>
+
+DScheduleCache::DScheduleCache(int maxCount)
+    : m_cache(maxCount)
+{
+}
+
+DSchedule::Ptr DScheduleCache::value(const QString &scheduleID, const QVariant &dtUpdate)
+{
+    QMutexLocker locker(&m_mutex);
+    CacheEntry *entry = m_cache.object(scheduleID);
+    if (entry == nullptr || entry->dtUpdate != dtUpdate) {
+        ++m_misses;
+        return DSchedule::Ptr();
+    }
+    ++m_hits;
+    //返回副本，避免调用方修改缓存中的数据
+    return DSchedule::Ptr(entry->schedule->clone());
+}
+
+void DScheduleCache::insert(const QString &scheduleID, const QVariant &dtUpdate, const DSchedule::Ptr &schedule)
+{
+    if (schedule.isNull()) {
+        return;
+    }
+    QMutexLocker locker(&m_mutex);
+    int count = m_cache.count() + (m_cache.contains(scheduleID) ? 0 : 1);
+    m_cache.insert(scheduleID, new CacheEntry {dtUpdate, DSchedule::Ptr(schedule->clone())});
+    m_evictions += static_cast<quint64>(count - m_cache.count());
+}
+
+void DScheduleCache::remove(const QString &scheduleID)
+{
+    QMutexLocker locker(&m_mutex);
+    m_cache.remove(scheduleID);
+}
+
+void DScheduleCache::clear()
+{
+    QMutexLocker locker(&m_mutex);
+    m_cache.clear();
+}
+
+int DScheduleCache::maxCount() const
+{
+    QMutexLocker locker(&m_mutex);
+    return m_cache.maxCost();
+}
+
+void DScheduleCache::setMaxCount(int maxCount)
+{
+    QMutexLocker locker(&m_mutex);
+    int count = m_cache.count();
+    m_cache.setMaxCost(maxCount);
+    m_evictions += static_cast<quint64>(count - m_cache.count());
+}
+
+QString DScheduleCache::toJsonString() const
+{
+    QMutexLocker locker(&m_mutex);
+    QJsonObject rootObj;
+    rootObj.insert("capacity", m_cache.maxCost());
+    rootObj.insert("count", m_cache.count());
+    rootObj.insert("hits", static_cast<qint64>(m_hits));
+    rootObj.insert("misses", static_cast<qint64>(m_misses));
+    rootObj.insert("evictions", static_cast<qint64>(m_evictions));
+    QJsonDocument jsonDoc;
+    jsonDoc.setObject(rootObj);
+    return QString::fromUtf8(jsonDoc.toJson(QJsonDocument::Compact));
+}
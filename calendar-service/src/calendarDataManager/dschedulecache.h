@@ -0,0 +1,54 @@
+// SPDX-FileCopyrightText: 2019 - 2022 UnionTech Software Technology Co., Ltd.
+//
+// SPDX-License-Identifier: LGPL-3.0-or-later
+
+#ifndef DSCHEDULECACHE_H
+#define DSCHEDULECACHE_H
+
+#include "dschedule.h"
+
+#include <QCache>
+#include <QMutex>
+#include <QVariant>
+#include <QSharedPointer>
+
+//帐户日程缓存
+//以日程id为键，缓存已解析的日程，日程修改时间(dtUpdate)不一致时视为未命中
+//超出容量时淘汰最久未使用的日程
+class DScheduleCache
+{
+public:
+    typedef QSharedPointer<DScheduleCache> Ptr;
+
+    explicit DScheduleCache(int maxCount = 5000);
+
+    /**
+     * @brief value         获取缓存的日程
+     * @param scheduleID    日程id
+     * @param dtUpdate      数据库中日程的修改时间
+     * @return              日程副本，未命中时返回空指针
+     */
+    DSchedule::Ptr value(const QString &scheduleID, const QVariant &dtUpdate);
+    void insert(const QString &scheduleID, const QVariant &dtUpdate, const DSchedule::Ptr &schedule);
+    void remove(const QString &scheduleID);
+    void clear();
+
+    int maxCount() const;
+    void setMaxCount(int maxCount);
+
+    //缓存统计信息，包含容量、数量、命中、未命中和淘汰次数
+    QString toJsonString() const;
+
+private:
+    struct CacheEntry {
+        QVariant dtUpdate;
+        DSchedule::Ptr schedule;
+    };
+    mutable QMutex m_mutex;
+    QCache<QString, CacheEntry> m_cache;
+    quint64 m_hits = 0;
+    quint64 m_misses = 0;
+    quint64 m_evictions = 0;
+};
+
+#endif // DSCHEDULECACHE_H
@@ -4,124 +4,193 @@
 
 #include "calendarhuangli.h"
 #include "lunarandfestival/lunarmanager.h"
+#include "commondef.h"
+
+#include <QJsonDocument>
+
+//一次最多获取3年的黄历信息
+static const qint64 MaxRangeDays = 366 * 3;
 
 CalendarHuangLi::CalendarHuangLi(QObject *parent)
     : QObject(parent)
-    , m_database(new DHuangLiDataBase(this))
 {
+    //缓存5年的数据，足够年视图前后切换使用
+    m_yearCache.setMaxCost(5);
+}
+
+DHuangLiDataBase *CalendarHuangLi::database()
+{
+    if (m_database == nullptr) {
+        m_database = new DHuangLiDataBase(this);
+    }
+    return m_database;
 }
 
 //获取指定公历月的假日信息
 QJsonArray CalendarHuangLi::getFestivalMonth(quint32 year, quint32 month)
 {
-    return m_database->queryFestivalList(year, month);
+    return database()->queryFestivalList(year, month);
+}
+
+//获取指定公历年的假日信息
+QJsonArray CalendarHuangLi::getFestivalYear(quint32 year)
+{
+    return database()->queryFestivalList(year);
 }
 
 QString CalendarHuangLi::getHuangLiDay(quint32 year, quint32 month, quint32 day)
 {
-    stDay viewday{static_cast<int>(year), static_cast<int>(month), static_cast<int>(day)};
-    QList<stDay> viewdate{viewday};
-    CaHuangLiDayInfo hldayinfo;
-    //获取阴历信息
-    stLunarDayInfo lunardayinfo = SolarToLunar(static_cast<qint32>(year), static_cast<qint32>(month), static_cast<qint32>(day));
-    //获取宜忌信息
-    QList<stHuangLi> hllist = m_database->queryHuangLiByDays(viewdate);
-    //将黄历信息保存到CaHuangLiDayInfo
-    hldayinfo.mSuit = hllist.begin()->Suit;
-    hldayinfo.mAvoid = hllist.begin()->Avoid;
-    hldayinfo.mGanZhiYear = lunardayinfo.GanZhiYear;
-    hldayinfo.mGanZhiMonth = lunardayinfo.GanZhiMonth;
-    hldayinfo.mGanZhiDay = lunardayinfo.GanZhiDay;
-    hldayinfo.mLunarDayName = lunardayinfo.LunarDayName;
-    hldayinfo.mLunarFestival = lunardayinfo.LunarFestival;
-    hldayinfo.mLunarLeapMonth = lunardayinfo.LunarLeapMonth;
-    hldayinfo.mLunarMonthName = lunardayinfo.LunarMonthName;
-    hldayinfo.mSolarFestival = lunardayinfo.SolarFestival;
-    hldayinfo.mTerm = lunardayinfo.Term;
-    hldayinfo.mZodiac = lunardayinfo.Zodiac;
-    hldayinfo.mWorktime = lunardayinfo.Worktime;
+    CaHuangLiMonthInfo monthinfo = cachedHuangLiMonth(static_cast<int>(year), static_cast<int>(month));
+    if (day < 1 || day > static_cast<quint32>(monthinfo.mCaLunarDayInfo.size())) {
+        return CaHuangLiDayInfo().toJson();
+    }
+    CaHuangLiDayInfo hldayinfo = monthinfo.mCaLunarDayInfo.at(static_cast<int>(day) - 1);
     //返回json
     return hldayinfo.toJson();
 }
 
 QString CalendarHuangLi::getHuangLiMonth(quint32 year, quint32 month, bool fill)
 {
-    CaHuangLiMonthInfo monthinfo;
-    SolarMonthInfo solarmonth = GetSolarMonthCalendar(static_cast<qint32>(year), static_cast<qint32>(month), fill);
-    LunarMonthInfo lunarmonth = GetLunarMonthCalendar(static_cast<qint32>(year), static_cast<qint32>(month), fill);
-    monthinfo.mFirstDayWeek = lunarmonth.FirstDayWeek;
-    monthinfo.mDays = lunarmonth.Days;
-    QList<stHuangLi> hllist = m_database->queryHuangLiByDays(solarmonth.Datas);
-    for (int i = 0; i < lunarmonth.Datas.size(); ++i) {
-        CaHuangLiDayInfo hldayinfo;
-        hldayinfo.mAvoid = hllist.at(i).Avoid;
-        hldayinfo.mSuit = hllist.at(i).Suit;
-        stLunarDayInfo lunardayinfo = lunarmonth.Datas.at(i);
-        hldayinfo.mGanZhiYear = lunardayinfo.GanZhiYear;
-        hldayinfo.mGanZhiMonth = lunardayinfo.GanZhiMonth;
-        hldayinfo.mGanZhiDay = lunardayinfo.GanZhiDay;
-        hldayinfo.mLunarDayName = lunardayinfo.LunarDayName;
-        hldayinfo.mLunarFestival = lunardayinfo.LunarFestival;
-        hldayinfo.mLunarLeapMonth = lunardayinfo.LunarLeapMonth;
-        hldayinfo.mLunarMonthName = lunardayinfo.LunarMonthName;
-        hldayinfo.mSolarFestival = lunardayinfo.SolarFestival;
-        hldayinfo.mTerm = lunardayinfo.Term;
-        hldayinfo.mZodiac = lunardayinfo.Zodiac;
-        hldayinfo.mWorktime = lunardayinfo.Worktime;
-        monthinfo.mCaLunarDayInfo.append(hldayinfo);
-//        qCDebug(ServiceLogger) << hldayinfo.mGanZhiYear << hldayinfo.mGanZhiMonth << hldayinfo.mGanZhiDay
-//                 << hldayinfo.mLunarDayName << hldayinfo.mLunarFestival << hldayinfo.mLunarFestival
-//                 << hldayinfo.mLunarLeapMonth << hldayinfo.mLunarMonthName << hldayinfo.mSolarFestival
-//                 << hldayinfo.mTerm << hldayinfo.mZodiac << hldayinfo.mWorktime;
-    }
-    return monthinfo.toJson();
+    return huangLiMonth(static_cast<int>(year), static_cast<int>(month), fill).toJson();
 }
 
 CaLunarDayInfo CalendarHuangLi::getLunarInfoBySolar(quint32 year, quint32 month, quint32 day)
 {
-    CaLunarDayInfo lunardayinfo;
-    //获取阴历信息
-    stLunarDayInfo m_lunardayinfo = SolarToLunar(static_cast<qint32>(year), static_cast<qint32>(month), static_cast<qint32>(day));
-    //将阴历信息保存到CaLunarDayInfo
-    lunardayinfo.mGanZhiYear = m_lunardayinfo.GanZhiYear;
-    lunardayinfo.mGanZhiMonth = m_lunardayinfo.GanZhiMonth;
-    lunardayinfo.mGanZhiDay = m_lunardayinfo.GanZhiDay;
-    lunardayinfo.mLunarDayName = m_lunardayinfo.LunarDayName;
-    lunardayinfo.mLunarFestival = m_lunardayinfo.LunarFestival;
-    lunardayinfo.mLunarLeapMonth = m_lunardayinfo.LunarLeapMonth;
-    lunardayinfo.mLunarMonthName = m_lunardayinfo.LunarMonthName;
-    lunardayinfo.mSolarFestival = m_lunardayinfo.SolarFestival;
-    lunardayinfo.mTerm = m_lunardayinfo.Term;
-    lunardayinfo.mZodiac = m_lunardayinfo.Zodiac;
-    lunardayinfo.mWorktime = m_lunardayinfo.Worktime;
+    CaHuangLiMonthInfo monthinfo = cachedHuangLiMonth(static_cast<int>(year), static_cast<int>(month));
+    if (day < 1 || day > static_cast<quint32>(monthinfo.mCaLunarDayInfo.size())) {
+        return CaLunarDayInfo();
+    }
     //返回CaLunarDayInfo
-    return lunardayinfo;
+    return toLunarDayInfo(monthinfo.mCaLunarDayInfo.at(static_cast<int>(day) - 1));
 }
 
 CaLunarMonthInfo CalendarHuangLi::getLunarCalendarMonth(quint32 year, quint32 month, bool fill)
 {
     CaLunarMonthInfo lunarmonthinfo;
-    //获取阴历月信息
-    LunarMonthInfo lunarmonth = GetLunarMonthCalendar(static_cast<qint32>(year), static_cast<qint32>(month), fill);
+    CaHuangLiMonthInfo monthinfo = huangLiMonth(static_cast<int>(year), static_cast<int>(month), fill);
     //将阴历月信息保存到CaLunarMonthInfo
-    lunarmonthinfo.mDays = lunarmonth.Days;
-    lunarmonthinfo.mFirstDayWeek = lunarmonth.FirstDayWeek;
-    for (int i = 0; i < lunarmonth.Datas.size(); ++i) {
-        CaLunarDayInfo m_lunardayinfo;
-        stLunarDayInfo lunardayinfo = lunarmonth.Datas.at(i);
-        m_lunardayinfo.mGanZhiYear = lunardayinfo.GanZhiYear;
-        m_lunardayinfo.mGanZhiMonth = lunardayinfo.GanZhiMonth;
-        m_lunardayinfo.mGanZhiDay = lunardayinfo.GanZhiDay;
-        m_lunardayinfo.mLunarDayName = lunardayinfo.LunarDayName;
-        m_lunardayinfo.mLunarFestival = lunardayinfo.LunarFestival;
-        m_lunardayinfo.mLunarLeapMonth = lunardayinfo.LunarLeapMonth;
-        m_lunardayinfo.mLunarMonthName = lunardayinfo.LunarMonthName;
-        m_lunardayinfo.mSolarFestival = lunardayinfo.SolarFestival;
-        m_lunardayinfo.mTerm = lunardayinfo.Term;
-        m_lunardayinfo.mZodiac = lunardayinfo.Zodiac;
-        m_lunardayinfo.mWorktime = lunardayinfo.Worktime;
-        lunarmonthinfo.mCaLunarDayInfo.append(m_lunardayinfo);
+    lunarmonthinfo.mDays = monthinfo.mDays;
+    lunarmonthinfo.mFirstDayWeek = monthinfo.mFirstDayWeek;
+    foreach (const CaHuangLiDayInfo &dayinfo, monthinfo.mCaLunarDayInfo) {
+        lunarmonthinfo.mCaLunarDayInfo.append(toLunarDayInfo(dayinfo));
     }
     //返回CaLunarMonthInfo
     return lunarmonthinfo;
 }
+
+QString CalendarHuangLi::getHuangLiRange(const QDate &startDate, const QDate &stopDate)
+{
+    QJsonArray daysarr;
+    if (startDate.isValid() && stopDate.isValid() && startDate <= stopDate
+            && startDate.daysTo(stopDate) < MaxRangeDays) {
+        //按月从缓存中取出数据，首尾月只取范围内的天
+        QDate monthDate(startDate.year(), startDate.month(), 1);
+        while (monthDate <= stopDate) {
+            CaHuangLiMonthInfo monthinfo = cachedHuangLiMonth(monthDate.year(), monthDate.month());
+            const int beginIndex = monthDate < startDate ? startDate.day() - 1 : 0;
+            const int endIndex = monthDate.addMonths(1) > stopDate ? stopDate.day() : monthinfo.mCaLunarDayInfo.size();
+            for (int i = beginIndex; i < endIndex && i < monthinfo.mCaLunarDayInfo.size(); ++i) {
+                daysarr.append(monthinfo.mCaLunarDayInfo.at(i).toJsonObject());
+            }
+            monthDate = monthDate.addMonths(1);
+        }
+    } else {
+        qCWarning(ServiceLogger) << "invalid huangli range:" << startDate << stopDate;
+    }
+    QJsonObject obj;
+    obj.insert("StartDate", startDate.toString("yyyy-MM-dd"));
+    obj.insert("Days", daysarr.size());
+    obj.insert("Datas", daysarr);
+    QJsonDocument doc;
+    doc.setObject(obj);
+    return QString::fromUtf8(doc.toJson(QJsonDocument::Compact));
+}
+
+CaHuangLiMonthInfo CalendarHuangLi::huangLiMonth(int year, int month, bool fill)
+{
+    CaHuangLiMonthInfo monthinfo = cachedHuangLiMonth(year, month);
+    if (!fill || monthinfo.mDays == 0) {
+        return monthinfo;
+    }
+    //与GetSolarMonthCalendar一致，前面补齐上月最后FirstDayWeek天，后面补齐下月数据至6*7天
+    const QDate firstDay(year, month, 1);
+    const int preDays = monthinfo.mFirstDayWeek;
+    const int nextDays = 6 * 7 - (preDays + monthinfo.mDays);
+    QVector<CaHuangLiDayInfo> daysData;
+    daysData.reserve(6 * 7);
+    if (preDays > 0) {
+        const QDate preMonth = firstDay.addMonths(-1);
+        CaHuangLiMonthInfo preMonthInfo = cachedHuangLiMonth(preMonth.year(), preMonth.month());
+        daysData.append(preMonthInfo.mCaLunarDayInfo.mid(preMonthInfo.mCaLunarDayInfo.size() - preDays));
+    }
+    daysData.append(monthinfo.mCaLunarDayInfo);
+    if (nextDays > 0) {
+        const QDate nextMonth = firstDay.addMonths(1);
+        daysData.append(cachedHuangLiMonth(nextMonth.year(), nextMonth.month()).mCaLunarDayInfo.mid(0, nextDays));
+    }
+    monthinfo.mCaLunarDayInfo = daysData;
+    return monthinfo;
+}
+
+CaHuangLiMonthInfo CalendarHuangLi::cachedHuangLiMonth(int year, int month)
+{
+    if (!QDate(year, month, 1).isValid()) {
+        return CaHuangLiMonthInfo();
+    }
+    HuangLiYearCache *yearCache = m_yearCache.object(year);
+    if (yearCache == nullptr) {
+        yearCache = new HuangLiYearCache;
+        m_yearCache.insert(year, yearCache);
+    }
+    const int index = month - 1;
+    if (!yearCache->valid[index]) {
+        SolarMonthInfo solarmonth = GetSolarMonthCalendar(year, month, false);
+        LunarMonthInfo lunarmonth = GetLunarMonthCalendar(solarmonth);
+        QList<stHuangLi> hllist = database()->queryHuangLiByDays(solarmonth.Datas);
+        CaHuangLiMonthInfo &monthinfo = yearCache->months[index];
+        monthinfo.mFirstDayWeek = lunarmonth.FirstDayWeek;
+        monthinfo.mDays = lunarmonth.Days;
+        monthinfo.mCaLunarDayInfo.reserve(lunarmonth.Datas.size());
+        for (int i = 0; i < lunarmonth.Datas.size(); ++i) {
+            monthinfo.mCaLunarDayInfo.append(toHuangLiDayInfo(lunarmonth.Datas.at(i), hllist.value(i)));
+        }
+        yearCache->valid[index] = true;
+    }
+    return yearCache->months[index];
+}
+
+CaHuangLiDayInfo CalendarHuangLi::toHuangLiDayInfo(const stLunarDayInfo &lunarInfo, const stHuangLi &huangLi)
+{
+    CaHuangLiDayInfo hldayinfo;
+    hldayinfo.mAvoid = huangLi.Avoid;
+    hldayinfo.mSuit = huangLi.Suit;
+    hldayinfo.mGanZhiYear = lunarInfo.GanZhiYear;
+    hldayinfo.mGanZhiMonth = lunarInfo.GanZhiMonth;
+    hldayinfo.mGanZhiDay = lunarInfo.GanZhiDay;
+    hldayinfo.mLunarDayName = lunarInfo.LunarDayName;
+    hldayinfo.mLunarFestival = lunarInfo.LunarFestival;
+    hldayinfo.mLunarLeapMonth = lunarInfo.LunarLeapMonth;
+    hldayinfo.mLunarMonthName = lunarInfo.LunarMonthName;
+    hldayinfo.mSolarFestival = lunarInfo.SolarFestival;
+    hldayinfo.mTerm = lunarInfo.Term;
+    hldayinfo.mZodiac = lunarInfo.Zodiac;
+    hldayinfo.mWorktime = lunarInfo.Worktime;
+    return hldayinfo;
+}
+
+CaLunarDayInfo CalendarHuangLi::toLunarDayInfo(const CaHuangLiDayInfo &huangLiInfo)
+{
+    CaLunarDayInfo lunardayinfo;
+    lunardayinfo.mGanZhiYear = huangLiInfo.mGanZhiYear;
+    lunardayinfo.mGanZhiMonth = huangLiInfo.mGanZhiMonth;
+    lunardayinfo.mGanZhiDay = huangLiInfo.mGanZhiDay;
+    lunardayinfo.mLunarDayName = huangLiInfo.mLunarDayName;
+    lunardayinfo.mLunarFestival = huangLiInfo.mLunarFestival;
+    lunardayinfo.mLunarLeapMonth = huangLiInfo.mLunarLeapMonth;
+    lunardayinfo.mLunarMonthName = huangLiInfo.mLunarMonthName;
+    lunardayinfo.mSolarFestival = huangLiInfo.mSolarFestival;
+    lunardayinfo.mTerm = huangLiInfo.mTerm;
+    lunardayinfo.mZodiac = huangLiInfo.mZodiac;
+    lunardayinfo.mWorktime = huangLiInfo.mWorktime;
+    return lunardayinfo;
+}
@@ -10,6 +10,8 @@
 #include <QJsonArray>
 
 #include <QObject>
+#include <QCache>
+#include <QDate>
 
 class DHuangLiDataBase;
 
@@ -20,13 +22,39 @@ public:
     explicit CalendarHuangLi(QObject *parent = nullptr);
 
     QJsonArray getFestivalMonth(quint32 year, quint32 month);
+    QJsonArray getFestivalYear(quint32 year);
     QString getHuangLiDay(quint32 year, quint32 month, quint32 day);
     QString getHuangLiMonth(quint32 year, quint32 month, bool fill);
     CaLunarDayInfo getLunarInfoBySolar(quint32 year, quint32 month, quint32 day);
     CaLunarMonthInfo getLunarCalendarMonth(quint32 year, quint32 month, bool fill);
+    /**
+     * @brief getHuangLiRange   获取时间范围内每天的黄历信息
+     * @param startDate         开始日期
+     * @param stopDate          结束日期，包含该天
+     * @return                  json字符串，Datas中按日期顺序保存从开始日期起每天的黄历信息，范围无效时Days为0
+     */
+    QString getHuangLiRange(const QDate &startDate, const QDate &stopDate);
 
 private:
-    DHuangLiDataBase *m_database;
+    //获取公历月每天的黄历信息，fill为true时用上下月数据补齐为6*7阵列
+    CaHuangLiMonthInfo huangLiMonth(int year, int month, bool fill);
+    //获取公历月每天的黄历信息(不补齐)，结果按年缓存
+    CaHuangLiMonthInfo cachedHuangLiMonth(int year, int month);
+    static CaHuangLiDayInfo toHuangLiDayInfo(const stLunarDayInfo &lunarInfo, const stHuangLi &huangLi);
+    static CaLunarDayInfo toLunarDayInfo(const CaHuangLiDayInfo &huangLiInfo);
+
+    //黄历数据库在第一次查询时打开，避免只处理提醒任务的启动过程打开数据库
+    DHuangLiDataBase *database();
+
+private:
+    DHuangLiDataBase *m_database = nullptr;
+    //一年中各月的黄历信息，月份未查询过时对应的valid为false
+    struct HuangLiYearCache {
+        CaHuangLiMonthInfo months[12];
+        bool valid[12] = {false};
+    };
+    //最近查询的若干年黄历信息，农历和黄历数据不会变化，无需失效
+    QCache<int, HuangLiYearCache> m_yearCache;
 };
 
 #endif // CALENDARHUANGLI_H
@@ -5,6 +5,8 @@
 #ifndef CALENDARPROGRAMEXITCONTROL_H
 #define CALENDARPROGRAMEXITCONTROL_H
 
+#include "dstartuptrace.h"
+
 #include <QReadWriteLock>
 
 /**
@@ -49,6 +51,7 @@ public:
     }
     ~DServiceExitControl()
     {
+        DStartupTrace::replied();
         CalendarProgramExitControl::getProgramExitControl()->reduce();
     }
     void setClientIsOpen(bool isOpen)
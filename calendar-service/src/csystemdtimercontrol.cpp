@@ -109,6 +109,14 @@ void CSystemdTimerControl::removeRemindFile(const QString &accountID)
     }
 }
 
+bool CSystemdTimerControl::hasRemindFile(const QString &accountID)
+{
+    QDir dir(m_systemdPath);
+    dir.setFilter(QDir::Files | QDir::NoSymLinks);
+    dir.setNameFilters(QStringList() << QString("calendar-remind-%1*").arg(accountID.mid(0,8)));
+    return dir.exists() && dir.count() > 0;
+}
+
 void CSystemdTimerControl::startCalendarServiceSystemdTimer()
 {
     // 清理玲珑包的残留
@@ -65,6 +65,11 @@ public:
      */
     void removeRemindFile(const QString &accountID);
 
+    /**
+     * @brief hasRemindFile         是否存在帐户的日程定时任务相关文件
+     */
+    bool hasRemindFile(const QString &accountID);
+
     /**
      * @brief startCalendarServiceSystemdTimer      开启日程后端定时器
      */
@@ -15,6 +15,162 @@
 #include <QSqlError>
 #include <QFile>
 
+#include <limits>
+
+//无截止时间的重复日程对应的范围截止值
+static const qint64 SpanInfinite = std::numeric_limits<qint64>::max();
+
+/**
+ * @brief scheduleSpanRange     计算日程可能产生实例的时间范围
+ * 普通日程为[开始时间，结束时间]，重复日程为[开始时间，最后一次重复的结束时间或无穷大]
+ * 前后各放宽一天，兼容全天日程和时区差异，范围内的日程仍由查询方精确过滤
+ */
+static void scheduleSpanRange(const DSchedule::Ptr &schedule, qint64 &spanStart, qint64 &spanEnd)
+{
+    QDate startDate = schedule->dtStart().date();
+    QDate endDate = schedule->dtEnd().date();
+    if (!endDate.isValid() || endDate < startDate) {
+        endDate = startDate;
+    }
+    spanStart = QDateTime(startDate.addDays(-1), QTime(0, 0)).toSecsSinceEpoch();
+    spanEnd = SpanInfinite;
+    if (schedule->recurs()) {
+        //农历重复日程无法根据公历规则计算截止时间，按永不截止处理
+        if (schedule->lunnar()) {
+            return;
+        }
+        QDateTime recurEnd = schedule->recurrence()->endDateTime();
+        if (!recurEnd.isValid()) {
+            return;
+        }
+        endDate = recurEnd.date().addDays(startDate.daysTo(endDate));
+    }
+    spanEnd = QDateTime(endDate.addDays(1), QTime(23, 59, 59)).toSecsSinceEpoch();
+}
+
+//更新日程有效时间范围语句
+static const QString sql_replace_scheduleSpan("REPLACE INTO scheduleSpan (scheduleID, spanStart, spanEnd, dtUpdate) VALUES(?, ?, ?, ?);");
+
+//绑定更新日程有效时间范围语句的参数
+static void bindScheduleSpan(QSqlQuery &query, const DSchedule::Ptr &schedule, const QVariant &dtUpdate)
+{
+    qint64 spanStart = 0;
+    qint64 spanEnd = 0;
+    scheduleSpanRange(schedule, spanStart, spanEnd);
+    query.addBindValue(schedule->schedulingID());
+    query.addBindValue(spanStart);
+    query.addBindValue(spanEnd);
+    query.addBindValue(dtUpdate);
+}
+
+//全天日程会在开始时间延后9小时提醒，计算下一次提醒时间时起点需要向前保留9小时
+static const int AlarmLookBackSecs = 9 * 60 * 60;
+//查找下一次提醒时间时最多展开的年数，超出后在查找截止时间重新计算
+static const int AlarmSearchYears = 10;
+
+/**
+ * @brief nextAlarmTime     获取日程不早于dtFrom的最近一次提醒时间
+ * 同一日程的提醒偏移固定，按年分段展开，找到的第一个提醒即为最近的提醒
+ * @return                  秒级时间戳，之后不再提醒时返回空
+ */
+static QVariant nextAlarmTime(const DSchedule::Ptr &schedule, const QDateTime &dtFrom)
+{
+    qint64 spanStart = 0;
+    qint64 spanEnd = 0;
+    scheduleSpanRange(schedule, spanStart, spanEnd);
+    //全天日程的提醒在开始时间之后，向前多展开一天
+    QDateTime dtStart = dtFrom.addDays(-1);
+    for (int i = 0; i < AlarmSearchYears && dtStart.toSecsSinceEpoch() <= spanEnd; ++i) {
+        QDateTime dtEnd = dtStart.addYears(1);
+        qint64 nextAlarm = SpanInfinite;
+        //最多提前一周提醒，结束时间+8天
+        foreach (auto occurrence, DSchedule::expandOccurrences(schedule, dtStart, dtEnd.addDays(8))) {
+            if (occurrence->alarms().size() > 0) {
+                const QDateTime dtAlarm = occurrence->alarms()[0]->time();
+                if (dtAlarm >= dtFrom) {
+                    nextAlarm = qMin(nextAlarm, dtAlarm.toSecsSinceEpoch());
+                }
+            }
+        }
+        if (nextAlarm != SpanInfinite) {
+            return nextAlarm;
+        }
+        dtStart = dtEnd;
+    }
+    if (dtStart.toSecsSinceEpoch() > spanEnd) {
+        return QVariant();
+    }
+    return dtStart.toSecsSinceEpoch();
+}
+
+//创建日程语句
+static const QString sql_insert_schedule("INSERT INTO schedules                                                   \
+                       (scheduleID, scheduleTypeID, summary, description, allDay, dtStart   \
+                       , dtEnd, isAlarm, titlePinyin,isLunar, ics, fileName, dtCreate, dtUpdate, isDeleted)   \
+                       VALUES(?, ?, ?, ?, ?, ?, ?, ?,?, ?, ?, ?, ?, ?, ?);");
+
+//绑定创建日程语句的参数
+static void bindInsertSchedule(QSqlQuery &query, const DSchedule::Ptr &schedule)
+{
+    query.addBindValue(schedule->schedulingID());
+    query.addBindValue(schedule->scheduleTypeID());
+    query.addBindValue(schedule->summary());
+    query.addBindValue(schedule->description());
+    query.addBindValue(schedule->allDay());
+    query.addBindValue(dtToString(schedule->dtStart()));
+    query.addBindValue(dtToString(schedule->dtEnd()));
+    query.addBindValue(schedule->hasEnabledAlarms());
+    query.addBindValue(pinyinsearch::getPinPinSearch()->CreatePinyin(schedule->summary()));
+    query.addBindValue(schedule->lunnar());
+    query.addBindValue(DSchedule::toIcsString(schedule));
+    query.addBindValue(schedule->fileName());
+    query.addBindValue(dtToString(schedule->created()));
+    //生成ics时可能会更新最后修改时间，需要在ics之后获取
+    query.addBindValue(dtToString(schedule->lastModified()));
+    query.addBindValue(0);
+}
+
+/**
+ * @brief splitIcsComponents    拆分ics中的VEVENT和VTIMEZONE组件
+ * @param events                VEVENT组件文本
+ * @param timezones             以TZID为键的VTIMEZONE组件文本
+ */
+static void splitIcsComponents(const QString &ics, QString &events, QMap<QString, QString> &timezones)
+{
+    QString component;
+    QString block;
+    QString tzid;
+    int depth = 0;
+    foreach (auto line, ics.split('\n')) {
+        if (line.endsWith('\r')) {
+            line.chop(1);
+        }
+        if (depth == 0) {
+            if (!line.startsWith("BEGIN:", Qt::CaseInsensitive) || line.startsWith("BEGIN:VCALENDAR", Qt::CaseInsensitive)) {
+                continue;
+            }
+            component = line.mid(6).trimmed().toUpper();
+        }
+        if (line.startsWith("BEGIN:", Qt::CaseInsensitive)) {
+            ++depth;
+        } else if (line.startsWith("END:", Qt::CaseInsensitive)) {
+            --depth;
+        } else if (depth == 1 && component == "VTIMEZONE" && line.startsWith("TZID:", Qt::CaseInsensitive)) {
+            tzid = line.mid(5);
+        }
+        block += line + "\r\n";
+        if (depth == 0) {
+            if (component == "VEVENT") {
+                events += block;
+            } else if (component == "VTIMEZONE" && !timezones.contains(tzid)) {
+                timezones.insert(tzid, block);
+            }
+            block.clear();
+            tzid.clear();
+        }
+    }
+}
+
 DAccountDataBase::DAccountDataBase(const DAccount::Ptr &account, QObject *parent)
     : DDataBase(parent)
     , m_account(account)
@@ -22,32 +178,56 @@ DAccountDataBase::DAccountDataBase(const DAccount::Ptr &account, QObject *parent
     setConnectionName(m_account->accountName());
 }
 
+void DAccountDataBase::setScheduleCache(const DScheduleCache::Ptr &scheduleCache)
+{
+    m_scheduleCache = scheduleCache;
+}
+
+void DAccountDataBase::transaction()
+{
+    if (m_transactionThread.loadAcquire() == QThread::currentThread()) {
+        ++m_transactionDepth;
+        return;
+    }
+    //其它线程的事务未结束时会在这里等待
+    SqliteQuery(m_database).transaction();
+    m_transactionThread.storeRelease(QThread::currentThread());
+    m_transactionDepth = 1;
+}
+
+void DAccountDataBase::commit()
+{
+    if (--m_transactionDepth > 0) {
+        return;
+    }
+    m_transactionThread.storeRelease(nullptr);
+    SqliteQuery(m_database).commit();
+}
+
+void DAccountDataBase::rollback()
+{
+    if (--m_transactionDepth > 0) {
+        return;
+    }
+    m_transactionThread.storeRelease(nullptr);
+    SqliteQuery(m_database).rollback();
+}
+
 QString DAccountDataBase::createSchedule(const DSchedule::Ptr &schedule)
 {
     if (!schedule.isNull()) {
         SqliteQuery query(m_database);
         schedule->setUid(DDataBase::createUuid());
 
-        QString strSql("INSERT INTO schedules                                                   \
-                       (scheduleID, scheduleTypeID, summary, description, allDay, dtStart   \
-                       , dtEnd, isAlarm, titlePinyin,isLunar, ics, fileName, dtCreate, isDeleted)   \
-                       VALUES(?, ?, ?, ?, ?, ?, ?, ?,?, ?, ?, ?, ?, ?);");
-        if (query.prepare(strSql)) {
-            query.addBindValue(schedule->schedulingID());
-            query.addBindValue(schedule->scheduleTypeID());
-            query.addBindValue(schedule->summary());
-            query.addBindValue(schedule->description());
-            query.addBindValue(schedule->allDay());
-            query.addBindValue(dtToString(schedule->dtStart()));
-            query.addBindValue(dtToString(schedule->dtEnd()));
-            query.addBindValue(schedule->hasEnabledAlarms());
-            query.addBindValue(pinyinsearch::getPinPinSearch()->CreatePinyin(schedule->summary()));
-            query.addBindValue(schedule->lunnar());
-            query.addBindValue(DSchedule::toIcsString(schedule));
-            query.addBindValue(schedule->fileName());
-            query.addBindValue(dtToString(schedule->created()));
-            query.addBindValue(0);
-            if (!query.exec()) {
+        if (query.prepare(sql_insert_schedule)) {
+            bindInsertSchedule(query, schedule);
+            if (query.exec()) {
+                //与写入日程表的修改时间一致
+                const QString dtUpdate = dtToString(schedule->lastModified());
+                updateScheduleSpan(schedule, dtUpdate);
+                updateScheduleAlarm(schedule, dtUpdate);
+                updateScheduleCache({{schedule->schedulingID(), dtUpdate, schedule}});
+            } else {
                 schedule->setUid("");
                 qCWarning(ServiceLogger) << "createSchedule error:" << query.lastError();
             }
@@ -66,6 +246,41 @@ QString DAccountDataBase::createSchedule(const DSchedule::Ptr &schedule)
     return schedule->uid();
 }
 
+int DAccountDataBase::createSchedules(const DSchedule::List &scheduleList)
+{
+    int count = 0;
+    if (scheduleList.isEmpty()) {
+        return count;
+    }
+    SqliteQuery query(m_database);
+    QVector<ScheduleCacheItem> cacheList;
+    transaction();
+    if (query.prepare(sql_insert_schedule)) {
+        foreach (auto &schedule, scheduleList) {
+            schedule->setUid(DDataBase::createUuid());
+            bindInsertSchedule(query, schedule);
+            if (query.exec()) {
+                const QString dtUpdate = dtToString(schedule->lastModified());
+                updateScheduleSpan(schedule, dtUpdate);
+                updateScheduleAlarm(schedule, dtUpdate);
+                cacheList.append({schedule->schedulingID(), dtUpdate, schedule});
+                ++count;
+            } else {
+                schedule->setUid("");
+                qCWarning(ServiceLogger) << "createSchedules error:" << query.lastError();
+            }
+        }
+    } else {
+        qCWarning(ServiceLogger) << "createSchedules error:" << query.lastError();
+    }
+    if (query.isActive()) {
+        query.finish();
+    }
+    commit();
+    updateScheduleCache(cacheList);
+    return count;
+}
+
 bool DAccountDataBase::updateSchedule(const DSchedule::Ptr &schedule)
 {
     bool resbool = false;
@@ -91,6 +306,12 @@ bool DAccountDataBase::updateSchedule(const DSchedule::Ptr &schedule)
             query.addBindValue(schedule->schedulingID());
             if (query.exec()) {
                 resbool = true;
+                updateScheduleSpan(schedule, dtToString(schedule->lastModified()));
+                updateScheduleAlarm(schedule, dtToString(schedule->lastModified()));
+                updateScheduleCache({{schedule->schedulingID(), dtToString(schedule->lastModified()), schedule}});
+                if (!m_scheduleCache.isNull()) {
+                    m_scheduleCache->remove(schedule->schedulingID());
+                }
             } else {
                 qCWarning(ServiceLogger) << Q_FUNC_INFO << query.lastError();
             }
@@ -107,18 +328,20 @@ bool DAccountDataBase::updateSchedule(const DSchedule::Ptr &schedule)
 
 DSchedule::Ptr DAccountDataBase::getScheduleByScheduleID(const QString &scheduleID)
 {
-    QString strSql("SELECT  scheduleID, scheduleTypeID, summary, description, allDay, dtStart, dtEnd,   \
-                   isAlarm,titlePinyin,isLunar, ics, fileName, dtCreate, dtUpdate, dtDelete, isDeleted  \
-                   FROM schedules WHERE  scheduleID  = ? ;");
+    QString strSql("SELECT  s.scheduleID, s.scheduleTypeID, s.summary, s.description, s.allDay, s.dtStart, s.dtEnd,   \
+                   s.isAlarm,s.titlePinyin,s.isLunar, s.ics, s.fileName, s.dtCreate, s.dtUpdate, s.dtDelete, s.isDeleted,  \
+                   sc.data as cacheData FROM schedules s                                                        \
+                   LEFT JOIN scheduleCache sc ON sc.scheduleID = s.scheduleID AND sc.dtUpdate IS s.dtUpdate     \
+                   WHERE  s.scheduleID  = ? ;");
     SqliteQuery query(m_database);
     DSchedule::Ptr schedule;
+    QVector<ScheduleCacheItem> staleList;
     if (query.prepare(strSql)) {
         query.addBindValue(scheduleID);
         schedule = DSchedule::Ptr(new DSchedule);
         if (query.exec()) {
             if (query.next()) {
-                QString &&icsStr = query.value("ics").toString();
-                DSchedule::fromIcsString(schedule, icsStr);
+                schedule = scheduleFromQuery(query, staleList);
                 schedule->setScheduleTypeID(query.value("scheduleTypeID").toString());
             }
         } else {
@@ -132,6 +355,7 @@ DSchedule::Ptr DAccountDataBase::getScheduleByScheduleID(const QString &schedule
         qCWarning(ServiceLogger) << Q_FUNC_INFO << query.lastError();
         return schedule;
     }
+    updateScheduleCache(staleList);
 
     return schedule;
 }
@@ -160,6 +384,48 @@ QStringList DAccountDataBase::getScheduleIDListByTypeID(const QString &typeID)
     return scheduleIDList;
 }
 
+bool DAccountDataBase::exportSchedulesByTypeID(const QString &typeID, QTextStream &stream)
+{
+    SqliteQuery query(m_database);
+    //只向前遍历，不缓存已读取的结果，导出时内存占用不随日程数量增长
+    query.setForwardOnly(true);
+    QMap<QString, QString> timezones;
+    QString events;
+    //导入时按批次解析日程，时区需要写在所有日程之前，先从包含时区的日程中收集时区
+    bool resBool = false;
+    if (query.prepare("SELECT ics FROM schedules WHERE scheduleTypeID = ? AND isDeleted = 0 AND instr(ics, 'BEGIN:VTIMEZONE') > 0;")) {
+        query.addBindValue(typeID);
+        resBool = query.exec();
+        while (resBool && query.next()) {
+            splitIcsComponents(query.value(0).toString(), events, timezones);
+            events.clear();
+        }
+    }
+    if (resBool) {
+        foreach (auto &timezone, timezones) {
+            stream << timezone;
+        }
+        resBool = query.prepare("SELECT ics FROM schedules WHERE scheduleTypeID = ? AND isDeleted = 0;");
+    }
+    if (resBool) {
+        query.addBindValue(typeID);
+        resBool = query.exec();
+        while (resBool && query.next()) {
+            QMap<QString, QString> scheduleTimezones;
+            splitIcsComponents(query.value(0).toString(), events, scheduleTimezones);
+            stream << events;
+            events.clear();
+        }
+    }
+    if (!resBool) {
+        qCWarning(ServiceLogger) << Q_FUNC_INFO << query.lastError();
+    }
+    if (query.isActive()) {
+        query.finish();
+    }
+    return resBool;
+}
+
 bool DAccountDataBase::deleteScheduleByScheduleID(const QString &scheduleID, const int isDeleted)
 {
     QString strSql;
@@ -181,6 +447,24 @@ bool DAccountDataBase::deleteScheduleByScheduleID(const QString &scheduleID, con
     if (query.isActive()) {
         query.finish();
     }
+    if (resBool && !m_scheduleCache.isNull()) {
+        m_scheduleCache->remove(scheduleID);
+    }
+    if (resBool && isDeleted) {
+        SqliteQuery spanQuery(m_database);
+        if (spanQuery.prepare("DELETE FROM scheduleSpan WHERE scheduleID=?;")) {
+            spanQuery.addBindValue(scheduleID);
+            spanQuery.exec();
+        }
+        if (spanQuery.prepare("DELETE FROM scheduleCache WHERE scheduleID=?;")) {
+            spanQuery.addBindValue(scheduleID);
+            spanQuery.exec();
+        }
+        if (spanQuery.prepare("DELETE FROM scheduleAlarm WHERE scheduleID=?;")) {
+            spanQuery.addBindValue(scheduleID);
+            spanQuery.exec();
+        }
+    }
 
     return resBool;
 }
@@ -207,35 +491,71 @@ bool DAccountDataBase::deleteSchedulesByScheduleTypeID(const QString &typeID, co
     if (query.isActive()) {
         query.finish();
     }
+    if (resBool && isDeleted) {
+        SqliteQuery spanQuery(m_database);
+        spanQuery.exec("DELETE FROM scheduleSpan WHERE scheduleID NOT IN (SELECT scheduleID FROM schedules);");
+        spanQuery.exec("DELETE FROM scheduleCache WHERE scheduleID NOT IN (SELECT scheduleID FROM schedules);");
+        spanQuery.exec("DELETE FROM scheduleAlarm WHERE scheduleID NOT IN (SELECT scheduleID FROM schedules);");
+    }
     return resBool;
 }
 
-DSchedule::List DAccountDataBase::querySchedulesByKey(const QString &key)
+DSchedule::List DAccountDataBase::querySchedulesByKey(const QString &key, const QDateTime &dtStart, const QDateTime &dtEnd)
 {
     DSchedule::List scheduleList;
     QString strSql("SELECT s.scheduleID, s.scheduleTypeID, s.summary, s.description, s.allDay, s.dtStart, s.dtEnd,   \
-             s.isAlarm,s.titlePinyin,s.isLunar, s.ics, s.fileName, s.dtCreate, s.dtUpdate, s.dtDelete, s.isDeleted      \
-               FROM  schedules s  inner join scheduleType st WHERE s.isDeleted = 0 and st.showState =1 and s.scheduleTypeID  = st.typeID ");
+             s.isAlarm,s.titlePinyin,s.isLunar, s.ics, s.fileName, s.dtCreate, s.dtUpdate, s.dtDelete, s.isDeleted,     \
+             sc.data as cacheData FROM  schedules s  inner join scheduleType st                                        \
+             LEFT JOIN scheduleCache sc ON sc.scheduleID = s.scheduleID AND sc.dtUpdate IS s.dtUpdate ");
+    QString strWhere(" WHERE s.isDeleted = 0 and st.showState =1 and s.scheduleTypeID  = st.typeID ");
+    QString strOrder(" order by s.dtStart asc ");
+    QMap<QString, QVariant> sqlBindValue;
+    //如果时间范围有效，通过有效时间范围索引过滤，只读取在查询范围内可能产生日程实例的数据
+    if (dtStart.isValid() && dtEnd.isValid()) {
+        strWhere += QString(" and s.scheduleID in (SELECT scheduleID FROM scheduleSpan WHERE spanEnd >= :spanStart and spanStart <= :spanEnd) ");
+        sqlBindValue[":spanStart"] = dtStart.toSecsSinceEpoch();
+        sqlBindValue[":spanEnd"] = dtEnd.toSecsSinceEpoch();
+    }
     //如果关键字不为空，添加查询条件
     pinyinsearch *psearch = pinyinsearch::getPinPinSearch();
-    QMap<QString, QString> sqlBindValue;
     QString strKey = key.trimmed();
-    if (psearch->CanQueryByPinyin(key)) {
+    bool canQueryByPinyin = psearch->CanQueryByPinyin(key);
+    if (m_searchEnabled && (canQueryByPinyin || !strKey.isEmpty())) {
+        //通过全文检索表查询标题、描述和拼音，按匹配程度排序
+        QString strSearch;
+        if (strKey.size() >= 3) {
+            //trigram分词至少需要3个字符，去掉首尾空白后按短语查询即为子串匹配，rank默认为bm25
+            strSearch = "SELECT rowid, rank FROM scheduleSearch WHERE scheduleSearch MATCH :match";
+            sqlBindValue[":match"] = QString("\"%1\"").arg(QString(strKey).replace("\"", "\"\""));
+        } else {
+            strSearch = "SELECT rowid, 0 AS rank FROM scheduleSearch WHERE instr(UPPER(summary), UPPER(:key)) OR instr(UPPER(description), UPPER(:descKey))";
+            sqlBindValue[":key"] = strKey;
+            sqlBindValue[":descKey"] = strKey;
+        }
+        if (canQueryByPinyin) {
+            //拼音匹配的日程排在文字匹配的日程之后
+            strSearch += " UNION ALL SELECT rowid, 1 AS rank FROM scheduleSearch WHERE pinyin LIKE :pinyin";
+            sqlBindValue[":pinyin"] = psearch->CreatePinyinQuery(strKey.toLower());
+        }
+        //检索表的rowid通过检索行号表对应到日程
+        strSql += QString(" inner join scheduleSearchRow sr ON sr.scheduleID = s.scheduleID "
+                          " inner join (SELECT rowid AS searchID, MIN(rank) AS searchRank FROM (%1) GROUP BY rowid) ss ON ss.searchID = sr.searchID ").arg(strSearch);
+        strOrder = " order by ss.searchRank asc, s.dtStart asc ";
+    } else if (canQueryByPinyin) {
         //可以按照拼音查询
         QString pinyin = psearch->CreatePinyinQuery(strKey.toLower());
-        strSql += QString("and ( instr(UPPER(s.summary), UPPER(:key)) OR s.titlePinyin LIKE :pinyin )");
+        strWhere += QString("and ( instr(UPPER(s.summary), UPPER(:key)) OR s.titlePinyin LIKE :pinyin )");
         sqlBindValue[":key"] = key;
         sqlBindValue[":pinyin"] = pinyin;
     } else if (!key.isEmpty()) {
         //按照key查询
-        strSql += QString(" and instr(UPPER(s.summary), UPPER(:key))");
+        strWhere += QString(" and instr(UPPER(s.summary), UPPER(:key))");
         sqlBindValue[":key"] = key;
     }
-
-    strSql.append(QString(" order by :strsort "));
-    sqlBindValue[":strsort"] = "s.dtStart asc";
+    strSql += strWhere + strOrder;
 
     SqliteQuery query(m_database);
+    QVector<ScheduleCacheItem> staleList;
     if (query.prepare(strSql)) {
         for (auto iter = sqlBindValue.constBegin(); iter != sqlBindValue.constEnd(); iter++) {
             query.bindValue(iter.key(), iter.value());
@@ -243,9 +563,7 @@ DSchedule::List DAccountDataBase::querySchedulesByKey(const QString &key)
 
         if (query.exec()) {
             while (query.next()) {
-                DSchedule::Ptr schedule;
-                QString &&icsStr = query.value("ics").toString();
-                DSchedule::fromIcsString(schedule, icsStr);
+                DSchedule::Ptr schedule = scheduleFromQuery(query, staleList);
                 schedule->setScheduleTypeID(query.value("scheduleTypeID").toString());
                 scheduleList.append(schedule);
             }
@@ -259,18 +577,21 @@ DSchedule::List DAccountDataBase::querySchedulesByKey(const QString &key)
     if (query.isActive()) {
         query.finish();
     }
+    updateScheduleCache(staleList);
     return scheduleList;
 }
 
 DSchedule::List DAccountDataBase::querySchedulesByRRule(const QString &key, const int &rruleType)
 {
     DSchedule::List scheduleList;
-    QString strSql("SELECT  scheduleID, scheduleTypeID, summary, description, allDay, dtStart, dtEnd,   \
-                   isAlarm,titlePinyin,isLunar, ics, fileName, dtCreate, dtUpdate, dtDelete, isDeleted  \
-                   FROM schedules ");
+    QString strSql("SELECT  s.scheduleID, s.scheduleTypeID, s.summary, s.description, s.allDay, s.dtStart, s.dtEnd,   \
+                   s.isAlarm,s.titlePinyin,s.isLunar, s.ics, s.fileName, s.dtCreate, s.dtUpdate, s.dtDelete, s.isDeleted,  \
+                   sc.data as cacheData FROM schedules s                                                        \
+                   LEFT JOIN scheduleCache sc ON sc.scheduleID = s.scheduleID AND sc.dtUpdate IS s.dtUpdate     ");
     SqliteQuery query(m_database);
+    QVector<ScheduleCacheItem> staleList;
     if (!key.isEmpty()) {
-        strSql += " WHERE  summary  = ? ";
+        strSql += " WHERE  s.summary  = ? ";
     }
     if (query.prepare(strSql)) {
         if (!key.isEmpty()) {
@@ -279,9 +600,7 @@ DSchedule::List DAccountDataBase::querySchedulesByRRule(const QString &key, cons
 
         if (query.exec()) {
             while (query.next()) {
-                DSchedule::Ptr schedule = DSchedule::Ptr(new DSchedule);
-                QString &&icsStr = query.value("ics").toString();
-                DSchedule::fromIcsString(schedule, icsStr);
+                DSchedule::Ptr schedule = scheduleFromQuery(query, staleList);
                 schedule->setScheduleTypeID(query.value("scheduleTypeID").toString());
                 DSchedule::RRuleType rRuleType = schedule->getRRuleType();
                 //如果存在重复规则
@@ -302,22 +621,27 @@ DSchedule::List DAccountDataBase::querySchedulesByRRule(const QString &key, cons
     if (query.isActive()) {
         query.finish();
     }
+    updateScheduleCache(staleList);
     return scheduleList;
 }
 
-DSchedule::List DAccountDataBase::getRemindSchedule()
+DSchedule::List DAccountDataBase::getRemindSchedule(const QDateTime &dtEnd)
 {
-    QString strSql("SELECT  scheduleID, scheduleTypeID, summary, description, allDay, dtStart, dtEnd, isAlarm,  \
-                   titlePinyin, isLunar, ics, fileName, dtCreate, dtUpdate, dtDelete, isDeleted                 \
-                   FROM schedules WHERE  isAlarm =1;");
+    //通过下一次提醒时间索引只读取范围内会提醒的日程
+    QString strSql("SELECT  s.scheduleID, s.scheduleTypeID, s.summary, s.description, s.allDay, s.dtStart, s.dtEnd, s.isAlarm,  \
+                   s.titlePinyin, s.isLunar, s.ics, s.fileName, s.dtCreate, s.dtUpdate, s.dtDelete, s.isDeleted,        \
+                   sc.data as cacheData FROM scheduleAlarm sa                                                           \
+                   INNER JOIN schedules s ON s.scheduleID = sa.scheduleID                                               \
+                   LEFT JOIN scheduleCache sc ON sc.scheduleID = s.scheduleID AND sc.dtUpdate IS s.dtUpdate             \
+                   WHERE  sa.nextAlarm <= ? AND s.isAlarm =1;");
     SqliteQuery query(m_database);
     DSchedule::List scheduleList;
+    QVector<ScheduleCacheItem> staleList;
     if (query.prepare(strSql)) {
+        query.addBindValue(dtEnd.toSecsSinceEpoch());
         if (query.exec()) {
             while (query.next()) {
-                DSchedule::Ptr schedule = DSchedule::Ptr(new DSchedule);
-                QString &&icsStr = query.value("ics").toString();
-                DSchedule::fromIcsString(schedule, icsStr);
+                DSchedule::Ptr schedule = scheduleFromQuery(query, staleList);
                 scheduleList.append(schedule);
             }
         } else {
@@ -330,9 +654,129 @@ DSchedule::List DAccountDataBase::getRemindSchedule()
     if (query.isActive()) {
         query.finish();
     }
+    updateScheduleCache(staleList);
     return scheduleList;
 }
 
+void DAccountDataBase::updateNextAlarm(const DSchedule::List &scheduleList, const QDateTime &dtFrom)
+{
+    if (scheduleList.isEmpty()) {
+        return;
+    }
+    SqliteQuery query(m_database);
+    //可能在外层事务中调用，使用可嵌套的事务
+    transaction();
+    if (query.prepare("UPDATE scheduleAlarm SET nextAlarm = ? WHERE scheduleID = ?;")) {
+        foreach (auto schedule, scheduleList) {
+            query.addBindValue(nextAlarmTime(schedule, dtFrom));
+            query.addBindValue(schedule->schedulingID());
+            if (!query.exec()) {
+                qCWarning(ServiceLogger) << Q_FUNC_INFO << query.lastError();
+            }
+        }
+    } else {
+        qCWarning(ServiceLogger) << Q_FUNC_INFO << query.lastError();
+    }
+    if (query.isActive()) {
+        query.finish();
+    }
+    commit();
+}
+
+void DAccountDataBase::refreshScheduleAlarm(const bool isRebuild)
+{
+    SqliteQuery query(m_database);
+    if (isRebuild && !query.exec("DELETE FROM scheduleAlarm;")) {
+        qCWarning(ServiceLogger) << Q_FUNC_INFO << query.lastError();
+    }
+    //清理已删除或已取消提醒的日程
+    if (!query.exec("DELETE FROM scheduleAlarm WHERE scheduleID NOT IN (SELECT scheduleID FROM schedules WHERE isAlarm = 1);")) {
+        qCWarning(ServiceLogger) << Q_FUNC_INFO << query.lastError();
+    }
+    //获取没有下一次提醒时间或已修改的提醒日程
+    QString strSql("SELECT s.scheduleID, s.ics, s.dtUpdate FROM schedules s                     \
+                   LEFT JOIN scheduleAlarm sa ON sa.scheduleID = s.scheduleID                   \
+                   WHERE s.isAlarm = 1 AND (sa.scheduleID IS NULL OR sa.dtUpdate IS NOT s.dtUpdate);");
+    QList<QPair<DSchedule::Ptr, QVariant>> staleList;
+    if (query.prepare(strSql) && query.exec()) {
+        while (query.next()) {
+            DSchedule::Ptr schedule;
+            if (DSchedule::fromIcsString(schedule, query.value("ics").toString())) {
+                //以数据库中的日程ID为准
+                schedule->setUid(query.value("scheduleID").toString());
+                staleList.append(qMakePair(schedule, query.value("dtUpdate")));
+            }
+        }
+    } else {
+        qCWarning(ServiceLogger) << Q_FUNC_INFO << query.lastError();
+    }
+    if (query.isActive()) {
+        query.finish();
+    }
+    if (staleList.isEmpty()) {
+        return;
+    }
+
+    transaction();
+    for (auto iter = staleList.constBegin(); iter != staleList.constEnd(); ++iter) {
+        updateScheduleAlarm(iter->first, iter->second);
+    }
+    commit();
+}
+
+void DAccountDataBase::refreshScheduleSpan()
+{
+    //获取没有有效时间范围或已过期的日程
+    QString strSql("SELECT s.scheduleID, s.ics, s.dtUpdate FROM schedules s                     \
+                   LEFT JOIN scheduleSpan sp ON sp.scheduleID = s.scheduleID                    \
+                   WHERE sp.scheduleID IS NULL OR sp.dtUpdate IS NOT s.dtUpdate;");
+    SqliteQuery query(m_database);
+    QList<QPair<DSchedule::Ptr, QVariant>> staleList;
+    if (query.prepare(strSql) && query.exec()) {
+        while (query.next()) {
+            DSchedule::Ptr schedule;
+            if (DSchedule::fromIcsString(schedule, query.value("ics").toString())) {
+                //以数据库中的日程ID为准
+                schedule->setUid(query.value("scheduleID").toString());
+                staleList.append(qMakePair(schedule, query.value("dtUpdate")));
+            }
+        }
+    } else {
+        qCWarning(ServiceLogger) << Q_FUNC_INFO << query.lastError();
+    }
+    if (query.isActive()) {
+        query.finish();
+    }
+
+    if (!staleList.isEmpty()) {
+        //旧版本数据库升级时需要补全所有日程，在同一个事务中复用预编译语句
+        //可能在导入等外层事务中调用，使用可嵌套的事务
+        transaction();
+        if (query.prepare(sql_replace_scheduleSpan)) {
+            for (auto iter = staleList.constBegin(); iter != staleList.constEnd(); ++iter) {
+                bindScheduleSpan(query, iter->first, iter->second);
+                if (!query.exec()) {
+                    qCWarning(ServiceLogger) << Q_FUNC_INFO << query.lastError();
+                }
+            }
+        } else {
+            qCWarning(ServiceLogger) << Q_FUNC_INFO << query.lastError();
+        }
+        if (query.isActive()) {
+            query.finish();
+        }
+        commit();
+    }
+
+    //清理已删除日程的时间范围和解析缓存
+    if (!query.exec("DELETE FROM scheduleSpan WHERE scheduleID NOT IN (SELECT scheduleID FROM schedules);")) {
+        qCWarning(ServiceLogger) << Q_FUNC_INFO << query.lastError();
+    }
+    if (!query.exec("DELETE FROM scheduleCache WHERE scheduleID NOT IN (SELECT scheduleID FROM schedules);")) {
+        qCWarning(ServiceLogger) << Q_FUNC_INFO << query.lastError();
+    }
+}
+
 void DAccountDataBase::initDBData()
 {
     //如果不存在对应的数据库则创建
@@ -342,12 +786,26 @@ void DAccountDataBase::initDBData()
         initScheduleDB();
         initScheduleType();
         initAccountDB();
+        m_dataCompleted = true;
     } else {
         //如果存在则连接数据库
         dbOpen();
     }
 }
 
+void DAccountDataBase::completeDBData()
+{
+    if (m_dataCompleted) {
+        return;
+    }
+    m_dataCompleted = true;
+    //旧版本数据库没有日程有效时间范围表、解析缓存表、全文检索表和提醒时间表，需要补全
+    initScheduleSpan();
+    initScheduleCache();
+    initScheduleSearch();
+    initScheduleAlarm();
+}
+
 QString DAccountDataBase::createScheduleType(const DScheduleType::Ptr &scheduleType)
 {
     QString strSql("INSERT INTO scheduleType (                      \
@@ -1057,6 +1515,223 @@ void DAccountDataBase::createDB()
         if (query.isActive()) {
             query.finish();
         }
+        //日程有效时间范围表
+        initScheduleSpan();
+        //日程解析缓存表
+        initScheduleCache();
+        //日程全文检索表
+        initScheduleSearch();
+        //日程下一次提醒时间表
+        initScheduleAlarm();
+    }
+}
+
+void DAccountDataBase::initScheduleSpan()
+{
+    SqliteQuery query(m_database);
+    if (!query.exec(sql_create_scheduleSpan)) {
+        qCWarning(ServiceLogger) << "scheduleSpan create failed.error:" << query.lastError();
+        return;
+    }
+    if (!query.exec(sql_create_scheduleSpanIndex)) {
+        qCWarning(ServiceLogger) << "scheduleSpan index create failed.error:" << query.lastError();
+    }
+    if (query.isActive()) {
+        query.finish();
+    }
+    refreshScheduleSpan();
+}
+
+void DAccountDataBase::updateScheduleSpan(const DSchedule::Ptr &schedule, const QVariant &dtUpdate)
+{
+    SqliteQuery query(m_database);
+    if (query.prepare(sql_replace_scheduleSpan)) {
+        bindScheduleSpan(query, schedule, dtUpdate);
+        if (!query.exec()) {
+            qCWarning(ServiceLogger) << Q_FUNC_INFO << query.lastError();
+        }
+    } else {
+        qCWarning(ServiceLogger) << Q_FUNC_INFO << query.lastError();
+    }
+    if (query.isActive()) {
+        query.finish();
+    }
+}
+
+void DAccountDataBase::initScheduleAlarm()
+{
+    SqliteQuery query(m_database);
+    if (!query.exec(sql_create_scheduleAlarm)) {
+        qCWarning(ServiceLogger) << "scheduleAlarm create failed.error:" << query.lastError();
+        return;
+    }
+    if (!query.exec(sql_create_scheduleAlarmIndex)) {
+        qCWarning(ServiceLogger) << "scheduleAlarm index create failed.error:" << query.lastError();
+    }
+    if (query.isActive()) {
+        query.finish();
+    }
+    refreshScheduleAlarm();
+}
+
+void DAccountDataBase::updateScheduleAlarm(const DSchedule::Ptr &schedule, const QVariant &dtUpdate)
+{
+    SqliteQuery query(m_database);
+    bool prepared = false;
+    if (schedule->hasEnabledAlarms()) {
+        prepared = query.prepare("REPLACE INTO scheduleAlarm (scheduleID, nextAlarm, dtUpdate) VALUES(?, ?, ?);");
+        if (prepared) {
+            query.addBindValue(schedule->schedulingID());
+            query.addBindValue(nextAlarmTime(schedule, QDateTime::currentDateTime().addSecs(-AlarmLookBackSecs)));
+            query.addBindValue(dtUpdate);
+        }
+    } else {
+        prepared = query.prepare("DELETE FROM scheduleAlarm WHERE scheduleID = ?;");
+        if (prepared) {
+            query.addBindValue(schedule->schedulingID());
+        }
+    }
+    if (!prepared || !query.exec()) {
+        qCWarning(ServiceLogger) << Q_FUNC_INFO << query.lastError();
+    }
+    if (query.isActive()) {
+        query.finish();
+    }
+}
+
+void DAccountDataBase::initScheduleCache()
+{
+    //缓存在读取日程时按需生成，这里只创建表
+    SqliteQuery query(m_database);
+    if (!query.exec(sql_create_scheduleCache)) {
+        qCWarning(ServiceLogger) << "scheduleCache create failed.error:" << query.lastError();
+    }
+    if (query.isActive()) {
+        query.finish();
+    }
+}
+
+void DAccountDataBase::initScheduleSearch()
+{
+    m_searchEnabled = false;
+    SqliteQuery query(m_database);
+    const QStringList triggerNameList {"trigger_scheduleSearch_before_insert", "trigger_scheduleSearch_after_insert",
+                                       "trigger_scheduleSearch_after_update", "trigger_scheduleSearch_after_delete"};
+    const QStringList triggerSqlList {sql_create_scheduleSearchBeforeInsert, sql_create_scheduleSearchAfterInsert,
+                                      sql_create_scheduleSearchAfterUpdate, sql_create_scheduleSearchAfterDelete};
+    bool exists = query.exec("SELECT name FROM sqlite_master WHERE type = 'table' and name = 'scheduleSearch'") && query.next();
+    const bool rowExists = query.exec("SELECT name FROM sqlite_master WHERE type = 'table' and name = 'scheduleSearchRow'") && query.next();
+    //检索表已存在但当前sqlite不支持fts5时，需要删除触发器，否则日程无法写入
+    //旧版本的检索表以schedules表的rowid关联，同样删除触发器，之后按检索行号重建
+    const bool available = !exists || query.exec("SELECT rowid FROM scheduleSearch LIMIT 1");
+    if (!available || (exists && !rowExists)) {
+        if (!available) {
+            qCWarning(ServiceLogger) << "scheduleSearch unavailable.error:" << query.lastError();
+        }
+        foreach (auto &triggerName, triggerNameList) {
+            query.exec(QString("DROP TRIGGER IF EXISTS %1").arg(triggerName));
+        }
+        if (!available) {
+            return;
+        }
+        if (!query.exec("DROP TABLE scheduleSearch")) {
+            qCWarning(ServiceLogger) << "scheduleSearch drop failed.error:" << query.lastError();
+            return;
+        }
+        exists = false;
+    }
+    if (!exists && !query.exec(sql_create_scheduleSearch)) {
+        qCWarning(ServiceLogger) << "scheduleSearch create failed.error:" << query.lastError();
+        return;
+    }
+    if (!query.exec(sql_create_scheduleSearchRow)) {
+        qCWarning(ServiceLogger) << "scheduleSearchRow create failed.error:" << query.lastError();
+        return;
+    }
+    foreach (auto &triggerSql, triggerSqlList) {
+        if (!query.exec(triggerSql)) {
+            qCWarning(ServiceLogger) << "scheduleSearch trigger create failed.error:" << query.lastError();
+            return;
+        }
+    }
+    //新建的检索表需要根据已有日程生成检索数据
+    if (!exists) {
+        const QStringList initSqlList {"DELETE FROM scheduleSearchRow",
+                                       "INSERT INTO scheduleSearchRow(scheduleID) SELECT scheduleID FROM schedules",
+                                       "INSERT INTO scheduleSearch(rowid, summary, description, pinyin) "
+                                       "SELECT sr.searchID, s.summary, s.description, s.titlePinyin FROM schedules s "
+                                       "INNER JOIN scheduleSearchRow sr ON sr.scheduleID = s.scheduleID"};
+        foreach (auto &initSql, initSqlList) {
+            if (!query.exec(initSql)) {
+                qCWarning(ServiceLogger) << "scheduleSearch init failed.error:" << query.lastError();
+                return;
+            }
+        }
+    }
+    if (query.isActive()) {
+        query.finish();
+    }
+    m_searchEnabled = true;
+}
+
+DSchedule::Ptr DAccountDataBase::scheduleFromQuery(const QSqlQuery &query, QVector<ScheduleCacheItem> &staleList)
+{
+    const QString scheduleID = query.value("scheduleID").toString();
+    const QVariant dtUpdate = query.value("dtUpdate");
+    DSchedule::Ptr schedule;
+    //优先从内存缓存获取
+    if (!m_scheduleCache.isNull()) {
+        schedule = m_scheduleCache->value(scheduleID, dtUpdate);
+        if (!schedule.isNull()) {
+            return schedule;
+        }
+    }
+    if (!DSchedule::fromBinary(schedule, query.value("cacheData").toByteArray())) {
+        //缓存不存在或已过期，解析ics并记录，由调用方统一回写
+        schedule = DSchedule::Ptr(new DSchedule);
+        if (!DSchedule::fromIcsString(schedule, query.value("ics").toString())) {
+            return schedule;
+        }
+        staleList.append({scheduleID, dtUpdate, schedule});
+    }
+    if (!m_scheduleCache.isNull()) {
+        m_scheduleCache->insert(scheduleID, dtUpdate, schedule);
+    }
+    return schedule;
+}
+
+void DAccountDataBase::updateScheduleCache(const QVector<ScheduleCacheItem> &cacheList)
+{
+    if (cacheList.isEmpty()) {
+        return;
+    }
+    SqliteQuery query(m_database);
+    //只有在日程未被修改时才写入，避免读取后日程被同步修改导致缓存数据错误
+    QString strSql("REPLACE INTO scheduleCache (scheduleID, dtUpdate, data)         \
+                   SELECT scheduleID, dtUpdate, ? FROM schedules                    \
+                   WHERE scheduleID = ? AND dtUpdate IS ?;");
+    //批量写入时使用事务，减少磁盘同步次数
+    if (cacheList.size() > 1) {
+        transaction();
+    }
+    if (query.prepare(strSql)) {
+        for (auto iter = cacheList.constBegin(); iter != cacheList.constEnd(); ++iter) {
+            query.addBindValue(DSchedule::toBinary(iter->schedule));
+            query.addBindValue(iter->scheduleID);
+            query.addBindValue(iter->dtUpdate);
+            if (!query.exec()) {
+                qCWarning(ServiceLogger) << Q_FUNC_INFO << query.lastError();
+                break;
+            }
+        }
+    } else {
+        qCWarning(ServiceLogger) << Q_FUNC_INFO << query.lastError();
+    }
+    if (query.isActive()) {
+        query.finish();
+    }
+    if (cacheList.size() > 1) {
+        commit();
     }
 }
 
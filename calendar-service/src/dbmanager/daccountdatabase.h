@@ -12,8 +12,11 @@
 #include "dreminddata.h"
 #include "duploadtaskdata.h"
 #include "dtypecolor.h"
+#include "dschedulecache.h"
 
 #include <QSharedPointer>
+#include <QTextStream>
+#include <QAtomicPointer>
 
 class DAccountDataBase : public DDataBase
 {
@@ -22,25 +25,59 @@ public:
     typedef QSharedPointer<DAccountDataBase> Ptr;
 
     explicit DAccountDataBase(const DAccount::Ptr &account, QObject *parent = nullptr);
+    //设置日程缓存，读取日程时优先从缓存获取
+    void setScheduleCache(const DScheduleCache::Ptr &scheduleCache);
     //初始化数据库数据，会创建数据库文件和相关数据表
+    //已存在的数据库只打开连接，旧版本数据库的补全在completeDBData中处理
     void initDBData() override;
+    /**
+     * @brief completeDBData    补全旧版本数据库缺少的数据表并刷新日程有效时间范围、提醒时间，只执行一次
+     * 在第一次读写日程数据前调用，避免启动时扫描所有帐户的日程
+     */
+    void completeDBData();
+    /**
+     * @brief transaction       开始事务，用于需要整体成功或失败的多次写入
+     * 同一线程中嵌套调用时合并到最外层的事务中，只有最外层的commit或rollback生效
+     */
+    void transaction();
+    void commit();
+    void rollback();
     ///////////////日程信息
     //创建日程
     QString createSchedule(const DSchedule::Ptr &schedule);
+    //批量创建日程，在一个事务中使用同一条预编译语句写入，返回创建成功的数量
+    int createSchedules(const DSchedule::List &scheduleList);
     bool updateSchedule(const DSchedule::Ptr &schedule);
     //根据日程id获取日程信息
     DSchedule::Ptr getScheduleByScheduleID(const QString &scheduleID);
 
     //根据日程类型ID获取日程id列表
     QStringList getScheduleIDListByTypeID(const QString &typeID);
+    /**
+     * @brief exportSchedulesByTypeID   将类型下所有日程的VEVENT及用到的VTIMEZONE写入数据流
+     * 直接使用数据库中保存的ics，不解析为日程，VTIMEZONE写在所有VEVENT之前
+     * @return                          是否成功
+     */
+    bool exportSchedulesByTypeID(const QString &typeID, QTextStream &stream);
     bool deleteScheduleByScheduleID(const QString &scheduleID, const int isDeleted = 0);
     bool deleteSchedulesByScheduleTypeID(const QString &typeID, const int isDeleted = 0);
-    //根据关键字查询一定范围内的日程
-    DSchedule::List querySchedulesByKey(const QString &key);
+    //根据关键字查询一定范围内的日程，若时间范围有效则只读取在范围内可能产生日程实例的数据
+    DSchedule::List querySchedulesByKey(const QString &key, const QDateTime &dtStart = QDateTime(), const QDateTime &dtEnd = QDateTime());
     //根据重复规则查询一定范围内的日程
     DSchedule::List querySchedulesByRRule(const QString &key, const int &rruleType);
-    //获取需要提醒的日程信息
-    DSchedule::List getRemindSchedule();
+    //获取下一次提醒时间不晚于dtEnd的日程
+    DSchedule::List getRemindSchedule(const QDateTime &dtEnd);
+    /**
+     * @brief updateNextAlarm       以dtFrom为起点重新计算日程的下一次提醒时间
+     */
+    void updateNextAlarm(const DSchedule::List &scheduleList, const QDateTime &dtFrom);
+    //补全缺失或过期的日程有效时间范围，云同步后需要调用
+    void refreshScheduleSpan();
+    /**
+     * @brief refreshScheduleAlarm  补全缺失或过期的日程下一次提醒时间，云同步后需要调用
+     * @param isRebuild             是否重新计算所有日程
+     */
+    void refreshScheduleAlarm(const bool isRebuild = false);
 
     ///////////////类型信息
     /**
@@ -120,9 +157,44 @@ protected:
     void initScheduleDB();
     void initTypeColor();
     void initAccountDB();
+    //初始化日程有效时间范围表
+    void initScheduleSpan();
+    //更新日程有效时间范围
+    void updateScheduleSpan(const DSchedule::Ptr &schedule, const QVariant &dtUpdate);
+
+    //需要写入解析缓存的日程
+    struct ScheduleCacheItem {
+        QString scheduleID;
+        QVariant dtUpdate;
+        DSchedule::Ptr schedule;
+    };
+    //初始化日程解析缓存表
+    void initScheduleCache();
+    /**
+     * @brief scheduleFromQuery     从查询结果中获取日程，优先使用二进制缓存，缓存无效时解析ics
+     * 查询语句需包含scheduleID、dtUpdate、ics列及缓存表的data列(cacheData)
+     * @param staleList             缓存无效的日程，用于回写缓存
+     */
+    DSchedule::Ptr scheduleFromQuery(const QSqlQuery &query, QVector<ScheduleCacheItem> &staleList);
+    //更新日程解析缓存
+    void updateScheduleCache(const QVector<ScheduleCacheItem> &cacheList);
+    //初始化日程全文检索表
+    void initScheduleSearch();
+    //初始化日程下一次提醒时间表
+    void initScheduleAlarm();
+    //更新日程下一次提醒时间，没有提醒的日程会被移除
+    void updateScheduleAlarm(const DSchedule::Ptr &schedule, const QVariant &dtUpdate);
 
 protected:
     DAccount::Ptr m_account;
+    DScheduleCache::Ptr m_scheduleCache;
+    //全文检索是否可用，sqlite不支持fts5时使用原有的查询方式
+    bool m_searchEnabled = false;
+    //旧版本数据库是否已补全
+    bool m_dataCompleted = false;
+    //开启事务的线程和事务嵌套层数，层数只在开启事务的线程中修改
+    QAtomicPointer<QThread> m_transactionThread;
+    int m_transactionDepth = 0;
 };
 
 #endif // DACCOUNTDATABASE_H
@@ -136,6 +136,82 @@ const QString DDataBase::sql_create_calendargeneralsettings =
     " vch_value TEXT NOT NULL           "
     " )";
 
+//日程有效时间范围表
+//spanStart/spanEnd为日程可能产生实例的时间范围（秒级时间戳），无截止的重复日程spanEnd为最大值
+const QString DDataBase::sql_create_scheduleSpan =
+    " CREATE TABLE if not exists scheduleSpan (  "
+    " scheduleID TEXT not null primary key,     "
+    " spanStart INTEGER not null,               "
+    " spanEnd INTEGER not null,                 "
+    " dtUpdate DATETIME)";
+
+const QString DDataBase::sql_create_scheduleSpanIndex =
+    " CREATE INDEX if not exists scheduleSpan_range ON scheduleSpan(spanEnd, spanStart)";
+
+//日程解析缓存表
+//data为日程二进制序列化数据，dtUpdate与schedules表中不一致时视为过期
+const QString DDataBase::sql_create_scheduleCache =
+    " CREATE TABLE if not exists scheduleCache (  "
+    " scheduleID TEXT not null primary key,      "
+    " dtUpdate DATETIME,                         "
+    " data BLOB)";
+
+//日程全文检索表的行号
+//schedules表没有整数主键，VACUUM或REPLACE INTO后rowid可能变化，检索表使用这里显式的整数主键作为rowid
+const QString DDataBase::sql_create_scheduleSearchRow =
+    " CREATE TABLE if not exists scheduleSearchRow (  "
+    " searchID INTEGER PRIMARY KEY,                  "
+    " scheduleID TEXT not null UNIQUE)";
+
+//日程全文检索表
+//rowid为scheduleSearchRow表的searchID，使用trigram分词支持中文子串查询，由触发器维护
+const QString DDataBase::sql_create_scheduleSearch =
+    " CREATE VIRTUAL TABLE if not exists scheduleSearch USING fts5(  "
+    " summary, description, pinyin, tokenize = 'trigram')";
+
+//replace into 替换已存在的日程时不会触发删除触发器，需要在插入前删除旧的检索数据
+const QString DDataBase::sql_create_scheduleSearchBeforeInsert =
+    " CREATE TRIGGER if not exists trigger_scheduleSearch_before_insert BEFORE INSERT ON schedules "
+    " BEGIN "
+    " DELETE FROM scheduleSearch WHERE rowid = (SELECT searchID FROM scheduleSearchRow WHERE scheduleID = NEW.scheduleID); "
+    " END";
+
+const QString DDataBase::sql_create_scheduleSearchAfterInsert =
+    " CREATE TRIGGER if not exists trigger_scheduleSearch_after_insert AFTER INSERT ON schedules "
+    " BEGIN "
+    " INSERT OR IGNORE INTO scheduleSearchRow(scheduleID) VALUES(NEW.scheduleID); "
+    " INSERT INTO scheduleSearch(rowid, summary, description, pinyin) "
+    " SELECT searchID, NEW.summary, NEW.description, NEW.titlePinyin FROM scheduleSearchRow WHERE scheduleID = NEW.scheduleID; "
+    " END";
+
+const QString DDataBase::sql_create_scheduleSearchAfterUpdate =
+    " CREATE TRIGGER if not exists trigger_scheduleSearch_after_update AFTER UPDATE OF scheduleID, summary, description, titlePinyin ON schedules "
+    " BEGIN "
+    " DELETE FROM scheduleSearch WHERE rowid = (SELECT searchID FROM scheduleSearchRow WHERE scheduleID = OLD.scheduleID); "
+    " UPDATE scheduleSearchRow SET scheduleID = NEW.scheduleID WHERE scheduleID = OLD.scheduleID; "
+    " INSERT OR IGNORE INTO scheduleSearchRow(scheduleID) VALUES(NEW.scheduleID); "
+    " INSERT INTO scheduleSearch(rowid, summary, description, pinyin) "
+    " SELECT searchID, NEW.summary, NEW.description, NEW.titlePinyin FROM scheduleSearchRow WHERE scheduleID = NEW.scheduleID; "
+    " END";
+
+const QString DDataBase::sql_create_scheduleSearchAfterDelete =
+    " CREATE TRIGGER if not exists trigger_scheduleSearch_after_delete AFTER DELETE ON schedules "
+    " BEGIN "
+    " DELETE FROM scheduleSearch WHERE rowid = (SELECT searchID FROM scheduleSearchRow WHERE scheduleID = OLD.scheduleID); "
+    " DELETE FROM scheduleSearchRow WHERE scheduleID = OLD.scheduleID; "
+    " END";
+
+//日程下一次提醒时间表
+//nextAlarm为不早于计算起点的最近一次提醒时间（秒级时间戳），为空表示之后不再提醒
+const QString DDataBase::sql_create_scheduleAlarm =
+    " CREATE TABLE if not exists scheduleAlarm (  "
+    " scheduleID TEXT not null primary key,      "
+    " nextAlarm INTEGER,                         "
+    " dtUpdate DATETIME)";
+
+const QString DDataBase::sql_create_scheduleAlarmIndex =
+    " CREATE INDEX if not exists scheduleAlarm_nextAlarm ON scheduleAlarm(nextAlarm)";
+
 const QString DDataBase::GWorkColorID = "0cecca8a-291b-46e2-bb92-63a527b77d46";
 const QString DDataBase::GLifeColorID = "6cfd1459-1085-47e9-8ca6-379d47ec319a";
 const QString DDataBase::GOtherColorID = "35e70047-98bb-49b9-8ad8-02d1c942f5d0";
@@ -42,6 +42,19 @@ public:
     static const QString sql_create_accountManager;
     //日历通用设置
     static const QString sql_create_calendargeneralsettings;
+    //日程有效时间范围表，仅用于本地查询加速，不参与云同步
+    static const QString sql_create_scheduleSpan;
+    static const QString sql_create_scheduleSpanIndex;
+    static const QString sql_create_scheduleCache;
+    static const QString sql_create_scheduleSearchRow;
+    static const QString sql_create_scheduleSearch;
+    static const QString sql_create_scheduleSearchBeforeInsert;
+    static const QString sql_create_scheduleSearchAfterInsert;
+    static const QString sql_create_scheduleSearchAfterUpdate;
+    static const QString sql_create_scheduleSearchAfterDelete;
+    //日程下一次提醒时间表，仅用于本地提醒任务更新，不参与云同步
+    static const QString sql_create_scheduleAlarm;
+    static const QString sql_create_scheduleAlarmIndex;
 
     //工作颜色id
     static const QString GWorkColorID;
@@ -17,6 +17,9 @@
 #include <QJsonArray>
 #include <QRandomGenerator>
 
+#include <algorithm>
+#include <numeric>
+
 const QString HolidayDir = ":/holiday-cn";
 const QString HolidayUpdateURLPrefix ="https://cdn-nu-common.uniontech.com/deepin-calendar";
 const QString HolidayUpdateDateSetKey = "festivalUpdateDate";
@@ -39,12 +42,9 @@ DHuangLiDataBase::DHuangLiDataBase(QObject *parent)
                        &DHuangLiDataBase::updateFestivalList);
 }
 
-// readJSON 会读取一个JSON文件，如果 cache 为 true，则会缓存对象，以供下次使用
-QJsonDocument DHuangLiDataBase::readJSON(QString filename, bool cache)
+// readJSON 会读取一个JSON文件
+QJsonDocument DHuangLiDataBase::readJSON(QString filename)
 {
-    if (cache && readJSONCache.contains(filename)) {
-        return readJSONCache.value(filename);
-    }
     qCDebug(ServiceLogger) << "read json file" << filename;
     QJsonDocument doc;
     QFile file(filename);
@@ -54,8 +54,7 @@ QJsonDocument DHuangLiDataBase::readJSON(QString filename, bool cache)
         auto data = file.readAll();
         doc = QJsonDocument::fromJson(data);
     }
-    readJSONCache.insert(filename, doc);
-    return readJSONCache.value(filename);
+    return doc;
 }
 
 void DHuangLiDataBase::updateFestivalList()
@@ -80,60 +79,118 @@ void DHuangLiDataBase::updateFestivalList()
     }
 }
 
-// queryFestivalList 查询指定月份的节假日列表
-QJsonArray DHuangLiDataBase::queryFestivalList(quint32 year, quint8 month)
+// festivalYear 获取指定年份的节假日数据，文件只在第一次使用时读取并按月整理，以供下次使用
+const DHuangLiDataBase::FestivalYear &DHuangLiDataBase::festivalYear(quint32 year)
 {
-    qCDebug(ServiceLogger) << "query festival list"
-                           << "year" << year << "month" << month;
-    QJsonArray dataset;
     auto filename = getAppCacheDir().filePath(QString("%1.json").arg(year));
     if (!QFile(filename).exists()) {
         filename = QString("%1/%2.json").arg(HolidayDir).arg(year);
     }
+    auto iter = m_festivalIndex.constFind(filename);
+    if (iter != m_festivalIndex.constEnd()) {
+        return iter.value();
+    }
     qCDebug(ServiceLogger) << "festival file name" << filename;
-    auto doc = readJSON(filename, true);
+    FestivalYear festival;
+    auto doc = readJSON(filename);
     for (auto val : doc.object().value("days").toArray()) {
         auto day = val.toObject();
         auto name = day.value("name").toString();
         auto date = QDate::fromString(day.value("date").toString(), "yyyy-MM-dd");
         auto isOffday = day.value("isOffDay").toBool();
-        if (quint32(date.year()) == year && quint32(date.month()) == month) {
+        if (quint32(date.year()) == year) {
             qCDebug(ServiceLogger) << "festival day" << name << date << isOffday;
             QJsonObject obj;
             obj.insert("name", name);
             obj.insert("date", date.toString("yyyy-MM-dd"));
             obj.insert("status", isOffday ? 1 : 2);
-            dataset.append(obj);
+            festival.months[date.month() - 1].append(obj);
+            festival.year.append(obj);
         }
     }
-    return dataset;
+    return m_festivalIndex.insert(filename, festival).value();
+}
+
+// queryFestivalList 查询指定月份的节假日列表
+QJsonArray DHuangLiDataBase::queryFestivalList(quint32 year, quint8 month)
+{
+    qCDebug(ServiceLogger) << "query festival list"
+                           << "year" << year << "month" << month;
+    if (month < 1 || month > 12) {
+        return QJsonArray();
+    }
+    return festivalYear(year).months[month - 1];
+}
+
+// queryFestivalList 查询指定年份的节假日列表
+QJsonArray DHuangLiDataBase::queryFestivalList(quint32 year)
+{
+    qCDebug(ServiceLogger) << "query festival list"
+                           << "year" << year;
+    return festivalYear(year).year;
 }
 
 QList<stHuangLi> DHuangLiDataBase::queryHuangLiByDays(const QList<stDay> &days)
 {
     QList<stHuangLi> infos;
-    SqliteQuery query(m_database);
-    foreach (stDay d, days) {
-        // 查询的id
-        qint64 id = QString().asprintf("%d%02d%02d", d.Year, d.Month, d.Day).toInt();
-        QString strsql("SELECT id, avoid, suit FROM huangli WHERE id = %1");
-        strsql = strsql.arg(id);
-        // 数据库中的宜忌信息是从2008年开始的
+    if (days.isEmpty()) {
+        return infos;
+    }
+    // 数据库中的宜忌信息是从2008年开始的
+    // 因此这里先将黄历内容初始化为只有id，查询到数据的再进行赋值
+    qint64 minID = 0;
+    qint64 maxID = 0;
+    infos.reserve(days.size());
+    foreach (const stDay &d, days) {
+        // 查询的id，格式为yyyyMMdd
         stHuangLi sthuangli;
-        // 因此这里先将sthuangli内容初始化
-        sthuangli.ID = id;
-        // 如果数据库中有查询到数据，则进行赋值，如果没有，则使用初始值
-        if (query.exec(strsql) && query.next()) {
-            sthuangli.ID = query.value("id").toInt();
-            sthuangli.Avoid = query.value("avoid").toString();
-            sthuangli.Suit = query.value("suit").toString();
+        sthuangli.ID = qint64(d.Year) * 10000 + d.Month * 100 + d.Day;
+        if (infos.isEmpty() || sthuangli.ID < minID) {
+            minID = sthuangli.ID;
+        }
+        if (infos.isEmpty() || sthuangli.ID > maxID) {
+            maxID = sthuangli.ID;
         }
-        // 将黄历数据放到list中
         infos.append(sthuangli);
     }
-    if (query.isActive()) {
-        query.finish();
+
+    if (m_huangLiRangeQuery.isNull()) {
+        m_huangLiRangeQuery.reset(new SqliteQuery(m_database));
+        if (!m_huangLiRangeQuery->prepare("SELECT id, avoid, suit FROM huangli WHERE id BETWEEN ? AND ? ORDER BY id")) {
+            qCWarning(ServiceLogger) << "prepare huangli query failed:" << m_huangLiRangeQuery->lastError();
+            m_huangLiRangeQuery.reset();
+            return infos;
+        }
+    }
+    SqliteQuery &query = *m_huangLiRangeQuery;
+    query.bindValue(0, minID);
+    query.bindValue(1, maxID);
+    if (!query.exec()) {
+        qCWarning(ServiceLogger) << "query huangli failed:" << query.lastError();
+        return infos;
+    }
+    // 范围查询的结果按id有序，将查询的日期也按id排序后依次合并
+    QVector<int> order(infos.size());
+    std::iota(order.begin(), order.end(), 0);
+    std::stable_sort(order.begin(), order.end(), [&infos](int left, int right) {
+        return infos.at(left).ID < infos.at(right).ID;
+    });
+    int pos = 0;
+    while (pos < order.size() && query.next()) {
+        const qint64 id = query.value(0).toLongLong();
+        while (pos < order.size() && infos.at(order.at(pos)).ID < id) {
+            ++pos;
+        }
+        // 相同日期可能被查询多次
+        while (pos < order.size() && infos.at(order.at(pos)).ID == id) {
+            stHuangLi &sthuangli = infos[order.at(pos)];
+            sthuangli.Avoid = query.value(1).toString();
+            sthuangli.Suit = query.value(2).toString();
+            ++pos;
+        }
     }
+    // 结束查询以释放读锁，预编译语句保留以供下次使用
+    query.finish();
     return infos;
 }
 
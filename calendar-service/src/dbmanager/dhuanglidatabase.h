@@ -11,6 +11,7 @@
 #include <QJsonArray>
 #include <QJsonDocument>
 #include <QSettings>
+#include <QScopedPointer>
 
 class DHuangLiDataBase : public DDataBase
 {
@@ -18,14 +19,25 @@ class DHuangLiDataBase : public DDataBase
 public:
     explicit DHuangLiDataBase(QObject *parent = nullptr);
     QJsonArray queryFestivalList(quint32 year, quint8 month);
+    //查询指定年份的节假日列表
+    QJsonArray queryFestivalList(quint32 year);
     QList<stHuangLi> queryHuangLiByDays(const QList<stDay> &days);
 
     void initDBData() override;
 private:
-    QJsonDocument readJSON(QString filename, bool cache);
-    QHash<QString, QJsonDocument> readJSONCache;
+    QJsonDocument readJSON(QString filename);
+    //一年的节假日数据，在读取文件时按月整理好
+    struct FestivalYear {
+        QJsonArray months[12];
+        QJsonArray year;
+    };
+    const FestivalYear &festivalYear(quint32 year);
+    //节假日文件名对应的节假日数据
+    QHash<QString, FestivalYear> m_festivalIndex;
     void updateFestivalList();
     QSettings m_settings;
+    //按id范围查询黄历的预编译语句，第一次查询时创建并在之后复用
+    QScopedPointer<SqliteQuery> m_huangLiRangeQuery;
 protected:
     //创建数据库
     void createDB() override;
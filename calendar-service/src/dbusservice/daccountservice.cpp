@@ -11,6 +11,8 @@ DAccountService::DAccountService(const QString &path, const QString &interface,
 {
     connect(m_accountModel.data(), &DAccountModule::signalScheduleUpdate, this, &DAccountService::scheduleUpdate);
     connect(m_accountModel.data(), &DAccountModule::signalScheduleTypeUpdate, this, &DAccountService::scheduleTypeUpdate);
+    connect(m_accountModel.data(), &DAccountModule::signalScheduleChanged, this, &DAccountService::scheduleChanged);
+    connect(m_accountModel.data(), &DAccountModule::signalImportProgress, this, &DAccountService::importProgress);
 
     connect(m_accountModel.data(), &DAccountModule::signalAccountState, this, [&]() {
         notifyPropertyChanged(getInterface(), "accountState");
@@ -132,6 +134,24 @@ QString DAccountService::querySchedulesWithParameter(const QString &params)
     return m_accountModel->querySchedulesWithParameter(params);
 }
 
+QByteArray DAccountService::querySchedulesWithParameterV2(const QString &params)
+{
+    DServiceExitControl exitControl;
+    if (!clientWhite(m_accountModel->account()->accountType())) {
+        return QByteArray();
+    }
+    return m_accountModel->querySchedulesWithParameterV2(params);
+}
+
+QByteArray DAccountService::queryScheduleOccurrences(const QString &params, int offset, int limit)
+{
+    DServiceExitControl exitControl;
+    if (!clientWhite(m_accountModel->account()->accountType())) {
+        return QByteArray();
+    }
+    return m_accountModel->queryScheduleOccurrences(params, offset, limit);
+}
+
 QString DAccountService::getSysColors()
 {
     DServiceExitControl exitControl;
@@ -141,6 +161,15 @@ QString DAccountService::getSysColors()
     return m_accountModel->getSysColors();
 }
 
+QString DAccountService::getScheduleCacheStatistics()
+{
+    DServiceExitControl exitControl;
+    if (!clientWhite(m_accountModel->account()->accountType())) {
+        return QString();
+    }
+    return m_accountModel->getScheduleCacheStatistics();
+}
+
 bool DAccountService::getExpand()
 {
     return m_accountModel->getExpand();
@@ -106,6 +106,22 @@ public slots:
      */
     Q_SCRIPTABLE QString querySchedulesWithParameter(const QString &params);
 
+    /**
+     * @brief querySchedulesWithParameterV2     根据查询参数查询日程
+     * @param params                            具体的查询参数
+     * @return                                  查询到的日程集，二进制格式，通过DSchedule::fromListBinary解析
+     */
+    Q_SCRIPTABLE QByteArray querySchedulesWithParameterV2(const QString &params);
+
+    /**
+     * @brief queryScheduleOccurrences          根据查询参数获取展开后的日程实例，重复日程的每次重复为一个实例
+     * @param params                            具体的查询参数
+     * @param offset                            分页偏移，按实例开始时间排序
+     * @param limit                             分页数量，小于等于0时返回全部
+     * @return                                  日程实例集，二进制格式，原日程只保存一次，通过DScheduleOccurrence::fromOccurrenceResult解析
+     */
+    Q_SCRIPTABLE QByteArray queryScheduleOccurrences(const QString &params, int offset, int limit);
+
     /**
      * @brief querySchedulesWithParameter       导出日程到ics文件
      * @param icsFilePath                       ics文件路径
@@ -127,10 +143,21 @@ public slots:
 
     Q_SCRIPTABLE QString getSysColors();
 
+    /**
+     * @brief getScheduleCacheStatistics        获取日程缓存统计信息
+     * @return                                  json格式，包含容量、数量、命中、未命中和淘汰次数，
+     *                                          occurrences为重复日程实例时间缓存的统计信息
+     */
+    Q_SCRIPTABLE QString getScheduleCacheStatistics();
+
 signals:
     //日程更新信号，日程颜色更新信号
     void scheduleUpdate();
     void scheduleTypeUpdate();
+    //日程变化信号，参数分别为新增、修改、删除的日程ID，在scheduleUpdate之前发送
+    void scheduleChanged(const QStringList &insertedIDs, const QStringList &updatedIDs, const QStringList &deletedIDs);
+    //导入日程进度信号，count为已导入的日程数量，percent为导入进度(0-100)
+    void importProgress(int count, int percent);
 
 private:
     //帐户列表是否展开
@@ -22,7 +22,18 @@ DHuangliService::DHuangliService(QObject *parent)
 QString DHuangliService::getFestivalMonth(quint32 year, quint32 month)
 {
     DServiceExitControl exitControl;
-    auto list = m_huangli->getFestivalMonth(year, month);
+    return festivalListToJson(m_huangli->getFestivalMonth(year, month));
+}
+
+// 获取指定公历年的假日信息，返回格式与getFestivalMonth相同，list中为全年的假日
+QString DHuangliService::getFestivalYear(quint32 year)
+{
+    DServiceExitControl exitControl;
+    return festivalListToJson(m_huangli->getFestivalYear(year));
+}
+
+QString DHuangliService::festivalListToJson(const QJsonArray &list)
+{
     // 保持接口返回值兼容
     QJsonArray result;
     if (!list.empty()) {
@@ -68,3 +79,12 @@ CaLunarMonthInfo DHuangliService::getLunarMonthCalendar(quint32 year, quint32 mo
     CaLunarMonthInfo huangliInfo = m_huangli->getLunarCalendarMonth(year, month, fill);
     return huangliInfo;
 }
+
+// 获取时间范围内每天的黄历信息，日期格式为yyyy-MM-dd，用于一次获取整年的数据
+QString DHuangliService::getHuangLiRange(const QString &startDate, const QString &stopDate)
+{
+    DServiceExitControl exitControl;
+    QString huangliInfo = m_huangli->getHuangLiRange(QDate::fromString(startDate, "yyyy-MM-dd"),
+                                                     QDate::fromString(stopDate, "yyyy-MM-dd"));
+    return huangliInfo;
+}
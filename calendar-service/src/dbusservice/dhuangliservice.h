@@ -20,10 +20,16 @@ public:
     explicit DHuangliService(QObject *parent = nullptr);
 public slots:
     Q_SCRIPTABLE QString getFestivalMonth(quint32 year, quint32 month);
+    Q_SCRIPTABLE QString getFestivalYear(quint32 year);
     Q_SCRIPTABLE QString getHuangLiDay(quint32 year, quint32 month, quint32 day);
     Q_SCRIPTABLE QString getHuangLiMonth(quint32 year, quint32 month, bool fill);
     Q_SCRIPTABLE CaLunarDayInfo getLunarInfoBySolar(quint32 year, quint32 month, quint32 day);
     Q_SCRIPTABLE CaLunarMonthInfo getLunarMonthCalendar(quint32 year, quint32 month, bool fill);
+    Q_SCRIPTABLE QString getHuangLiRange(const QString &startDate, const QString &stopDate);
+private:
+    //将假日列表转换为getFestivalMonth兼容的格式
+    static QString festivalListToJson(const QJsonArray &list);
+
 private:
     CalendarHuangLi *m_huangli;
 };
@@ -0,0 +1,44 @@
+// SPDX-FileCopyrightText: 2019 - 2022 UnionTech Software Technology Co., Ltd.
+//
+// SPDX-License-Identifier: LGPL-3.0-or-later
+
+#include "dstartuptrace.h"
+
+#include "commondef.h"
+
+#include <QElapsedTimer>
+
+namespace {
+QElapsedTimer startupTimer;
+bool isEventLoopStarted = false;
+bool isReplied = false;
+} // namespace
+
+void DStartupTrace::start()
+{
+    startupTimer.start();
+}
+
+void DStartupTrace::stage(const QString &name)
+{
+    if (!startupTimer.isValid()) {
+        return;
+    }
+    qCDebug(ServiceLogger) << "startup trace:" << name << startupTimer.elapsed() << "ms";
+}
+
+void DStartupTrace::eventLoopStarted()
+{
+    isEventLoopStarted = true;
+    stage("event loop started");
+}
+
+void DStartupTrace::replied()
+{
+    //服务构造过程中的接口调用不是DBus应答，不做记录
+    if (!isEventLoopStarted || isReplied || !startupTimer.isValid()) {
+        return;
+    }
+    isReplied = true;
+    qCInfo(ServiceLogger) << "startup trace: first dbus reply" << startupTimer.elapsed() << "ms";
+}
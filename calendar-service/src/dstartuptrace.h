@@ -0,0 +1,40 @@
+// SPDX-FileCopyrightText: 2019 - 2022 UnionTech Software Technology Co., Ltd.
+//
+// SPDX-License-Identifier: LGPL-3.0-or-later
+
+#ifndef DSTARTUPTRACE_H
+#define DSTARTUPTRACE_H
+
+#include <QString>
+
+/**
+ * @brief The DStartupTrace class
+ * 后端程序启动耗时跟踪
+ * 从main开始计时，记录各启动阶段耗时以及事件循环启动后第一个DBus接口返回的耗时
+ */
+class DStartupTrace
+{
+public:
+    /**
+     * @brief start     开始计时，在main入口处调用
+     */
+    static void start();
+
+    /**
+     * @brief stage     记录启动阶段耗时
+     * @param name      阶段名称
+     */
+    static void stage(const QString &name);
+
+    /**
+     * @brief eventLoopStarted      事件循环已启动，之后返回的第一个DBus接口为首次应答
+     */
+    static void eventLoopStarted();
+
+    /**
+     * @brief replied       DBus接口处理结束，只记录首次应答的耗时
+     */
+    static void replied();
+};
+
+#endif // DSTARTUPTRACE_H
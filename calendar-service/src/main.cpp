@@ -5,6 +5,8 @@
 #include "dservicemanager.h"
 #include "ddatabasemanagement.h"
 #include "commondef.h"
+#include "dstartuptrace.h"
+#include "doccurrencecache.h"
 #include <DLog>
 
 #include <QDBusConnection>
@@ -45,6 +47,7 @@ bool loadTranslator(QCoreApplication *app, QList<QLocale> localeFallback = QList
 
 int main(int argc, char *argv[])
 {
+    DStartupTrace::start();
     QCoreApplication a(argc, argv);
     a.setOrganizationName("deepin");
     a.setApplicationName("dde-calendar-service");
@@ -58,9 +61,14 @@ int main(int argc, char *argv[])
         qCDebug(ServiceLogger) << "loadtranslator failed";
     }
 
+    //后端为所有帐户展开重复日程，实例时间缓存使用较大的容量
+    DOccurrenceCache::instance()->setMaxCost(200000);
+
     DDataBaseManagement dbManagement;
+    DStartupTrace::stage("database management");
 
     DServiceManager serviceManager;
+    DStartupTrace::stage("service registered");
 
     //如果存在迁移，则更新提醒
     if(dbManagement.hasTransfer()){
@@ -69,6 +77,7 @@ int main(int argc, char *argv[])
           serviceManager.updateRemindJob();
         });
     }
+    QTimer::singleShot(0, &DStartupTrace::eventLoopStarted);
     qCDebug(ServiceLogger) << "dde-calendar-service start";
     return a.exec();
 }
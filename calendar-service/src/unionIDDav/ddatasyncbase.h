@@ -48,6 +48,8 @@ signals:
     //
     void signalUpdate(const UpdateTypes updateType);
     void signalSyncState(const int syncState);
+    //日程数据发生变化，参数分别为新增、修改、删除的日程ID
+    void signalScheduleChanged(const QStringList &insertedIDs, const QStringList &updatedIDs, const QStringList &deletedIDs);
 };
 Q_DECLARE_OPERATORS_FOR_FLAGS(DDataSyncBase::UpdateTypes)
 Q_DECLARE_OPERATORS_FOR_FLAGS(DDataSyncBase::SyncTypes)
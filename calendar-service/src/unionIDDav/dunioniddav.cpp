@@ -19,6 +19,9 @@
 #include <QThread>
 #include <QMutex>
 #include <QSet>
+#include <QHash>
+#include <QDataStream>
+#include <QCryptographicHash>
 
 #include <unistd.h>
 
@@ -233,6 +236,11 @@ void DUIDSynDataWorker::startUpdate()
 
     qCInfo(ServiceLogger) << "同步完成";
     if (errCode == 0) {
+        //发送日程变化的ID，需要在数据更新消息之前发送
+        if (mSync.tableChanges.contains("schedules")) {
+            const SyncTableChange &change = mSync.tableChanges["schedules"];
+            emit signalScheduleChanged(change.inserted, change.updated, change.deleted);
+        }
         //发送数据更新消息
         emit signalUpdate(updateType);
     }
@@ -246,6 +254,7 @@ DUnionIDDav::DUnionIDDav()
 {
     connect(d, &DUIDSynDataPrivate::signalUpdate, this, &DUnionIDDav::signalUpdate);
     connect(d, &DUIDSynDataPrivate::signalSyncState, this, &DUnionIDDav::signalSyncState);
+    connect(d, &DUIDSynDataPrivate::signalScheduleChanged, this, &DUnionIDDav::signalScheduleChanged);
 }
 
 DUnionIDDav::~DUnionIDDav()
@@ -405,19 +414,23 @@ int SyncStack::tmpToLoad(DDataSyncBase::UpdateTypes &updateType)
 {
     if (accountState & DAccount::Account_Calendar) {
         qCInfo(ServiceLogger) << "更新schedules、schedules、typeColor";
-        if (!syncIntoTable("schedules", dbname_sync_thread, dbname_account_thread)){
-            qCWarning(ServiceLogger)<<"faild:" <<__FUNCTION__ <<" : "<<__LINE__;
-            return -1;
+        foreach (auto table_name, QStringList({"schedules", "scheduleType", "typeColor"})) {
+            SyncTableChange change;
+            if (!syncIntoTable(table_name, dbname_sync_thread, dbname_account_thread, &change)){
+                qCWarning(ServiceLogger)<<"faild:" <<__FUNCTION__ <<" : "<<__LINE__;
+                return -1;
+            }
+            if (!change.isEmpty()) {
+                tableChanges.insert(table_name, change);
+            }
         }
-        if (!syncIntoTable("scheduleType", dbname_sync_thread, dbname_account_thread)){
-            qCWarning(ServiceLogger)<<"faild:" <<__FUNCTION__ <<" : "<<__LINE__;
-            return -1;
+        //只有数据发生变化时才通知更新
+        if (tableChanges.contains("schedules")) {
+            updateType |= DUnionIDDav::Update_Schedule;
         }
-        if (!syncIntoTable("typeColor", dbname_sync_thread, dbname_account_thread)){
-            qCWarning(ServiceLogger)<<"faild:" <<__FUNCTION__ <<" : "<<__LINE__;
-            return -1;
+        if (tableChanges.contains("scheduleType") || tableChanges.contains("typeColor")) {
+            updateType |= DUnionIDDav::Update_ScheduleType;
         }
-        updateType = DUnionIDDav::Update_Schedule | DUnionIDDav::Update_ScheduleType;
     }
 
     if (accountState & DAccount::Account_Setting) {
@@ -463,26 +476,109 @@ void SyncStack::prepareBinds(QSqlQuery &query, QSqlRecord source)
         query.addBindValue(source.value(k));
 }
 
-bool SyncStack::syncIntoTable(const QString &table_name, const QString &connection_name_source, const QString &connection_name_target)
+/**
+ * @brief recordDigest  获取一行数据的摘要，用于比较两个数据库中同一行数据是否一致
+ */
+static QByteArray recordDigest(const QSqlRecord &record)
+{
+    QByteArray data;
+    QDataStream stream(&data, QIODevice::WriteOnly);
+    for (int k = 0; k < record.count(); k++) {
+        const QVariant value = record.value(k);
+        stream << value.isNull() << value.toString();
+    }
+    return QCryptographicHash::hash(data, QCryptographicHash::Md5);
+}
+
+bool SyncStack::syncIntoTable(const QString &table_name, const QString &connection_name_source, const QString &connection_name_target, SyncTableChange *change)
 {
+    const QString key_name = primaryKeyName(table_name, connection_name_target);
+    if (key_name.isEmpty()) {
+        qCWarning(ServiceLogger) << "can not find primary key, table_name:" << table_name;
+        return false;
+    }
+    //目标表现有数据的摘要，key为主键
+    QHash<QString, QByteArray> targetDigests;
+    {
+        SqliteQuery target(QSqlDatabase::database(connection_name_target));
+        target.setForwardOnly(true);
+        if (!target.exec(" select * from " + table_name)) {
+            qCWarning(ServiceLogger) << target.lastError() << "table_name:" << table_name;
+            return false;
+        }
+        while (target.next()) {
+            const QSqlRecord record = target.record();
+            targetDigests.insert(record.value(key_name).toString(), recordDigest(record));
+        }
+    }
+
     SqliteQuery source(QSqlDatabase::database(connection_name_source));
     SqliteQuery target(QSqlDatabase::database(connection_name_target));
-    if (!target.exec(" delete from " + table_name)){
-        qCWarning(ServiceLogger) << target.lastError() <<"table_name:"<<table_name;
+    source.setForwardOnly(true);
+    if (!source.exec(" select * from " + table_name)) {
+        qCWarning(ServiceLogger) << source.lastError() << "table_name:" << table_name;
         return false;
     }
-    source.exec(" select * from " + table_name);
+    SyncTableChange tableChange;
+    bool prepared = false;
     while (source.next()) {
-        target.prepare("replace into " + table_name + " values(" + prepareQuest(source.record().count()) + ")");
-        prepareBinds(target, source.record());
+        const QSqlRecord record = source.record();
+        const QString key_value = record.value(key_name).toString();
+        auto iter = targetDigests.find(key_value);
+        if (iter == targetDigests.end()) {
+            tableChange.inserted.append(key_value);
+        } else {
+            const bool isSame = iter.value() == recordDigest(record);
+            targetDigests.erase(iter);
+            if (isSame) {
+                continue;
+            }
+            tableChange.updated.append(key_value);
+        }
+        //所有变化的数据共用同一条预处理语句
+        if (!prepared) {
+            prepared = target.prepare("replace into " + table_name + " values(" + prepareQuest(record.count()) + ")");
+            if (!prepared) {
+                qCWarning(ServiceLogger) << target.lastError() << "table_name:" << table_name;
+                return false;
+            }
+        }
+        prepareBinds(target, record);
         if (!target.exec()) {
             qCWarning(ServiceLogger) << target.lastError();
             return false;
         }
     }
+
+    //源表中已不存在的数据
+    if (!targetDigests.isEmpty()) {
+        if (!target.prepare("delete from " + table_name + " where " + key_name + " = ?")) {
+            qCWarning(ServiceLogger) << target.lastError() << "table_name:" << table_name;
+            return false;
+        }
+        for (auto iter = targetDigests.constBegin(); iter != targetDigests.constEnd(); ++iter) {
+            target.addBindValue(iter.key());
+            if (!target.exec()) {
+                qCWarning(ServiceLogger) << target.lastError();
+                return false;
+            }
+            tableChange.deleted.append(iter.key());
+        }
+    }
+
+    qCInfo(ServiceLogger) << "sync table:" << table_name << "inserted:" << tableChange.inserted.size()
+                          << "updated:" << tableChange.updated.size() << "deleted:" << tableChange.deleted.size();
+    if (change != nullptr) {
+        *change = tableChange;
+    }
     return true;
 }
 
+QString SyncStack::primaryKeyName(const QString &table_name, const QString &connection_name)
+{
+    return selectValue(QString("SELECT name FROM pragma_table_info('%1') WHERE pk = 1").arg(table_name), connection_name).toString();
+}
+
 QSqlRecord SyncStack::selectRecord(const QString &table_name, const QString &key_name, const QVariant &key_value, const QString &connection_name)
 {
     SqliteQuery query(connection_name);
@@ -608,6 +704,7 @@ DUnionIDDav::DUIDSynDataPrivate::DUIDSynDataPrivate()
 
     connect(mWorker, &DUIDSynDataWorker::signalUpdate, this, &DUIDSynDataPrivate::signalUpdate);
     connect(mWorker, &DUIDSynDataWorker::signalSyncState, this, &DUIDSynDataPrivate::signalSyncState);
+    connect(mWorker, &DUIDSynDataWorker::signalScheduleChanged, this, &DUIDSynDataPrivate::signalScheduleChanged);
     connect(this, &DUIDSynDataPrivate::signalSyncData, mWorker, &DUIDSynDataWorker::syncData);
 
     mThread->start();
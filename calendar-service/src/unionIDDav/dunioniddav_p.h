@@ -14,6 +14,20 @@
 #include <QSqlRecord>
 #include <QSqlError>
 
+/**
+ * @brief The SyncTableChange struct 记录同步时单个表中发生变化的主键
+ */
+struct SyncTableChange {
+    QStringList inserted;   //新增
+    QStringList updated;    //修改
+    QStringList deleted;    //删除
+
+    bool isEmpty() const
+    {
+        return inserted.isEmpty() && updated.isEmpty() && deleted.isEmpty();
+    }
+};
+
 /**
      * @brief The SyncStack struct 记录单次上传的信息和相关操作
      */
@@ -45,6 +59,7 @@ struct SyncStack {
 
     //sync
     QString dbpath_sync;
+    QMap<QString, SyncTableChange> tableChanges; //下载同步时本地各表的变化，key为表名
 
     //func
     //下载云端数据
@@ -61,8 +76,10 @@ struct SyncStack {
     QString prepareQuest(int count);
     //sql bindvalue
     void prepareBinds(QSqlQuery &query, QSqlRecord source);
-    //sql sync db1.table to  db2.table
-    bool syncIntoTable(const QString &table_name, const QString &connection_name_source, const QString &connection_name_target);
+    //sql sync db1.table to  db2.table, 只写入有差异的数据, change记录变化的主键
+    bool syncIntoTable(const QString &table_name, const QString &connection_name_source, const QString &connection_name_target, SyncTableChange *change = nullptr);
+    //sql primary key of table
+    QString primaryKeyName(const QString &table_name, const QString &connection_name);
     //sql select first record
     QSqlRecord selectRecord(const QString &table_name, const QString &key_name, const QVariant &key_value, const QString &connection_name);
     //sql replace db1.record to  db2.table
@@ -164,6 +181,7 @@ public slots:
 signals:
     void signalUpdate(const DDataSyncBase::UpdateTypes updateType);
     void signalSyncState(const int syncState);
+    void signalScheduleChanged(const QStringList &insertedIDs, const QStringList &updatedIDs, const QStringList &deletedIDs);
 
 private:
     void startUpdate();
@@ -193,6 +211,7 @@ public:
 signals:
     void signalUpdate(const DDataSyncBase::UpdateTypes updateType);
     void signalSyncState(const int syncState);
+    void signalScheduleChanged(const QStringList &insertedIDs, const QStringList &updatedIDs, const QStringList &deletedIDs);
 
     void signalSyncData(const SyncStack syncType);
 
@@ -0,0 +1,71 @@
+// SPDX-FileCopyrightText: 2019 - 2022 UnionTech Software Technology Co., Ltd.
+//
+// SPDX-License-Identifier: LGPL-3.0-or-later
+
+#include "accountdatabasefixture.h"
+
+AccountDataBaseFixture::AccountDataBaseFixture()
+    : m_connectionName(DDataBase::createUuid())
+{
+    DAccount::Ptr account(new DAccount(DAccount::Account_Local));
+    account->setAccountID(DDataBase::createUuid());
+    account->setAccountName(m_connectionName);
+    m_accountDB.reset(new DAccountDataBase(account));
+    m_accountDB->setDBPath(m_dir.filePath(m_connectionName + ".db"));
+    m_accountDB->initDBData();
+}
+
+AccountDataBaseFixture::~AccountDataBaseFixture()
+{
+    m_accountDB.reset();
+    QSqlDatabase::removeDatabase(m_connectionName);
+}
+
+DAccountDataBase::Ptr AccountDataBaseFixture::accountDB() const
+{
+    return m_accountDB;
+}
+
+QString AccountDataBaseFixture::filePath(const QString &fileName) const
+{
+    return m_dir.filePath(fileName);
+}
+
+DSchedule::Ptr AccountDataBaseFixture::createSchedule(const QString &summary, int index)
+{
+    const QDateTime dtStart(QDate(2023, 1, 1), QTime(9, 0));
+    DSchedule::Ptr schedule(new DSchedule);
+    schedule->setSummary(summary);
+    schedule->setDescription(QString("description %1").arg(index));
+    schedule->setScheduleTypeID("107c369e-b13a-4d45-9ff3-de4eb3c0475b");
+    schedule->setDtStart(dtStart.addSecs(index * 600));
+    schedule->setDtEnd(dtStart.addSecs(index * 600 + 3600));
+    switch (index % 4) {
+    case 0:
+        schedule->recurrence()->setDaily(1);
+        break;
+    case 1:
+        schedule->recurrence()->setWeekly(1);
+        break;
+    default:
+        break;
+    }
+    if (index % 5 == 0) {
+        KCalendarCore::Alarm::Ptr alarm(new KCalendarCore::Alarm(schedule.data()));
+        alarm->setEnabled(true);
+        alarm->setType(KCalendarCore::Alarm::Display);
+        alarm->setDisplayAlarm(summary);
+        alarm->setStartOffset(KCalendarCore::Duration(-15 * 60));
+        schedule->addAlarm(alarm);
+    }
+    return schedule;
+}
+
+DSchedule::List AccountDataBaseFixture::createSchedules(int count)
+{
+    DSchedule::List scheduleList;
+    for (int i = 0; i < count; ++i) {
+        scheduleList.append(createSchedule(QString("schedule %1").arg(i), i));
+    }
+    return scheduleList;
+}
@@ -0,0 +1,34 @@
+// SPDX-FileCopyrightText: 2019 - 2022 UnionTech Software Technology Co., Ltd.
+//
+// SPDX-License-Identifier: LGPL-3.0-or-later
+
+#ifndef ACCOUNTDATABASEFIXTURE_H
+#define ACCOUNTDATABASEFIXTURE_H
+
+#include "daccountdatabase.h"
+
+#include <QTemporaryDir>
+
+/**
+ * @brief The AccountDataBaseFixture class  临时目录中新建的本地帐户数据库
+ */
+class AccountDataBaseFixture
+{
+public:
+    AccountDataBaseFixture();
+    ~AccountDataBaseFixture();
+
+    DAccountDataBase::Ptr accountDB() const;
+    QString filePath(const QString &fileName) const;
+
+    //创建日程，按序号设置重复规则和提醒
+    static DSchedule::Ptr createSchedule(const QString &summary, int index = 0);
+    static DSchedule::List createSchedules(int count);
+
+private:
+    QTemporaryDir m_dir;
+    QString m_connectionName;
+    DAccountDataBase::Ptr m_accountDB;
+};
+
+#endif // ACCOUNTDATABASEFIXTURE_H
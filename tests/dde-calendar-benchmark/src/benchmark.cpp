@@ -0,0 +1,39 @@
+// SPDX-FileCopyrightText: 2019 - 2022 UnionTech Software Technology Co., Ltd.
+//
+// SPDX-License-Identifier: LGPL-3.0-or-later
+
+#include "benchmark.h"
+
+#include <QElapsedTimer>
+#include <QPair>
+#include <QVector>
+#include <QDebug>
+
+//已注册的基准测试，各文件的静态变量初始化时注册
+static QVector<QPair<QString, Benchmark::Function>> &benchmarkList()
+{
+    static QVector<QPair<QString, Benchmark::Function>> list;
+    return list;
+}
+
+Benchmark::Benchmark(const char *name, Function function)
+{
+    benchmarkList().append(qMakePair(QString::fromLatin1(name), function));
+}
+
+int Benchmark::run(const QString &filter)
+{
+    int count = 0;
+    foreach (auto &benchmark, benchmarkList()) {
+        if (!benchmark.first.contains(filter, Qt::CaseInsensitive)) {
+            continue;
+        }
+        qInfo() << "[ RUN      ]" << benchmark.first;
+        QElapsedTimer timer;
+        timer.start();
+        benchmark.second();
+        qInfo() << "[     DONE ]" << benchmark.first << timer.elapsed() << "ms";
+        ++count;
+    }
+    return count;
+}
@@ -0,0 +1,34 @@
+// SPDX-FileCopyrightText: 2019 - 2022 UnionTech Software Technology Co., Ltd.
+//
+// SPDX-License-Identifier: LGPL-3.0-or-later
+
+#ifndef BENCHMARK_H
+#define BENCHMARK_H
+
+#include <QString>
+
+/**
+ * @brief The Benchmark class   基准测试
+ * 大数据量的耗时统计，只输出结果不做断言，不随单元测试运行
+ */
+class Benchmark
+{
+public:
+    typedef void (*Function)();
+    Benchmark(const char *name, Function function);
+
+    /**
+     * @brief run       运行名称包含过滤条件的基准测试
+     * @param filter    过滤条件，为空时运行全部
+     * @return          运行的基准测试数量
+     */
+    static int run(const QString &filter);
+};
+
+//定义并注册基准测试
+#define CALENDAR_BENCHMARK(name)                                            \
+    static void benchmark_##name();                                         \
+    static const Benchmark benchmarkRegister_##name(#name, benchmark_##name); \
+    static void benchmark_##name()
+
+#endif // BENCHMARK_H
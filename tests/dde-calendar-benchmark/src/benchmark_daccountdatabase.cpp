@@ -0,0 +1,138 @@
+// SPDX-FileCopyrightText: 2019 - 2022 UnionTech Software Technology Co., Ltd.
+//
+// SPDX-License-Identifier: LGPL-3.0-or-later
+
+#include "benchmark.h"
+#include "accountdatabasefixture.h"
+
+#include "calformat.h"
+#include "icalformat.h"
+#include "memorycalendar.h"
+
+#include <QElapsedTimer>
+#include <QFile>
+#include <QTextStream>
+#include <QSqlQuery>
+#include <QDebug>
+
+//50000条日程逐条解析ics和反序列化二进制缓存的耗时
+CALENDAR_BENCHMARK(scheduleCacheDecode)
+{
+    const int count = 50000;
+    AccountDataBaseFixture fixture;
+    DAccountDataBase::Ptr accountDB = fixture.accountDB();
+    if (accountDB->createSchedules(AccountDataBaseFixture::createSchedules(count)) != count) {
+        qWarning() << "create schedules failed";
+        return;
+    }
+    //第一次查询时写入二进制缓存
+    accountDB->querySchedulesByKey("");
+
+    QStringList icsList;
+    QList<QByteArray> dataList;
+    SqliteQuery query(accountDB->m_database);
+    if (query.exec("SELECT s.ics, sc.data FROM schedules s INNER JOIN scheduleCache sc ON sc.scheduleID = s.scheduleID;")) {
+        while (query.next()) {
+            icsList.append(query.value("ics").toString());
+            dataList.append(query.value("data").toByteArray());
+        }
+    }
+    query.finish();
+
+    QElapsedTimer timer;
+    timer.start();
+    int icsCount = 0;
+    foreach (auto &ics, icsList) {
+        DSchedule::Ptr schedule;
+        icsCount += DSchedule::fromIcsString(schedule, ics) ? 1 : 0;
+    }
+    const qint64 icsElapsed = timer.nsecsElapsed();
+
+    timer.restart();
+    int binaryCount = 0;
+    foreach (auto &data, dataList) {
+        DSchedule::Ptr schedule;
+        binaryCount += DSchedule::fromBinary(schedule, data) ? 1 : 0;
+    }
+    const qint64 binaryElapsed = timer.nsecsElapsed();
+
+    qInfo() << "decode" << icsCount << "ics:" << icsElapsed / qMax(icsCount, 1) / 1000.0 << "us/row,"
+            << binaryCount << "binary:" << binaryElapsed / qMax(binaryCount, 1) / 1000.0 << "us/row";
+}
+
+//100000条日程中按关键字查询的耗时，查询结果已写入二进制缓存
+CALENDAR_BENCHMARK(scheduleSearch)
+{
+    const int count = 100000;
+    AccountDataBaseFixture fixture;
+    DAccountDataBase::Ptr accountDB = fixture.accountDB();
+    if (!accountDB->m_searchEnabled) {
+        qInfo() << "sqlite does not support fts5, skip";
+        return;
+    }
+    const QStringList words {"周会", "评审", "培训", "出差", "体检", "聚餐", "面试", "汇报", "复盘", "值班"};
+    const QDateTime dtStart(QDate(2023, 1, 1), QTime(9, 0));
+    DSchedule::List scheduleList;
+    for (int i = 0; i < count; ++i) {
+        DSchedule::Ptr schedule(new DSchedule);
+        schedule->setSummary(QString("%1%2号").arg(words.at(i % words.size())).arg(i));
+        schedule->setDescription(QString("第%1组").arg(i % 1000));
+        schedule->setDtStart(dtStart.addSecs(i * 600));
+        schedule->setDtEnd(dtStart.addSecs(i * 600 + 3600));
+        scheduleList.append(schedule);
+    }
+    if (accountDB->createSchedules(scheduleList) != count) {
+        qWarning() << "create schedules failed";
+        return;
+    }
+
+    //分别为唯一匹配、约100条匹配的三字以上关键字、拼音和两个字的关键字
+    const QStringList keys {"评审12341号", "第123组", "pingshen", "体检"};
+    foreach (auto &key, keys) {
+        //第一次查询时写入二进制缓存
+        accountDB->querySchedulesByKey(key);
+        QElapsedTimer timer;
+        timer.start();
+        const int resultCount = accountDB->querySchedulesByKey(key).size();
+        qInfo() << "search" << key << "in" << count << "schedules:" << resultCount << "results," << timer.nsecsElapsed() / 1000000.0 << "ms";
+    }
+}
+
+//20000条日程分别逐条读取后使用ICalFormat导出和直接写入数据库中的ics的耗时
+CALENDAR_BENCHMARK(exportSchedules)
+{
+    const QString typeID = "107c369e-b13a-4d45-9ff3-de4eb3c0475b";
+    const int count = 20000;
+    AccountDataBaseFixture fixture;
+    DAccountDataBase::Ptr accountDB = fixture.accountDB();
+    if (accountDB->createSchedules(AccountDataBaseFixture::createSchedules(count)) != count) {
+        qWarning() << "create schedules failed";
+        return;
+    }
+
+    QElapsedTimer timer;
+    timer.start();
+    KCalendarCore::MemoryCalendar::Ptr cal(new KCalendarCore::MemoryCalendar(nullptr));
+    foreach (auto &scheduleID, accountDB->getScheduleIDListByTypeID(typeID)) {
+        cal->addEvent(accountDB->getScheduleByScheduleID(scheduleID));
+    }
+    const QString icalResult = KCalendarCore::ICalFormat().toString(cal.staticCast<KCalendarCore::Calendar>());
+    const qint64 icalElapsed = timer.restart();
+
+    QFile file(fixture.filePath("export.ics"));
+    if (!file.open(QIODevice::WriteOnly | QIODevice::Truncate)) {
+        qWarning() << "can not open" << file.fileName();
+        return;
+    }
+    QTextStream stream(&file);
+    stream.setCodec("UTF-8");
+    stream << "BEGIN:VCALENDAR\r\nPRODID:" << KCalendarCore::CalFormat::productId() << "\r\nVERSION:2.0\r\n";
+    accountDB->exportSchedulesByTypeID(typeID, stream);
+    stream << "END:VCALENDAR\r\n";
+    stream.flush();
+    file.close();
+    const qint64 streamElapsed = timer.elapsed();
+
+    qInfo() << "export" << count << "schedules, ICalFormat:" << icalElapsed << "ms," << icalResult.toUtf8().size() << "bytes;"
+            << "stream:" << streamElapsed << "ms," << file.size() << "bytes";
+}
@@ -0,0 +1,44 @@
+// SPDX-FileCopyrightText: 2019 - 2022 UnionTech Software Technology Co., Ltd.
+//
+// SPDX-License-Identifier: LGPL-3.0-or-later
+
+#include "benchmark.h"
+#include "config.h"
+#include "dbmanager/dhuanglidatabase.h"
+
+#include <QElapsedTimer>
+#include <QFile>
+#include <QDebug>
+
+//一年的黄历信息一次范围查询与逐天查询的耗时
+CALENDAR_BENCHMARK(queryHuangLiByDays)
+{
+    if (!QFile::exists(HL_DATABASE_DIR)) {
+        qWarning() << "can not find" << HL_DATABASE_DIR;
+        return;
+    }
+    DHuangLiDataBase huangLiDB;
+    huangLiDB.m_database.close();
+    huangLiDB.m_database.setDatabaseName(HL_DATABASE_DIR);
+    if (!huangLiDB.m_database.open()) {
+        qWarning() << "can not open" << HL_DATABASE_DIR;
+        return;
+    }
+    QList<stDay> days;
+    for (QDate date(2021, 1, 1); date.year() == 2021; date = date.addDays(1)) {
+        days.append(stDay{date.year(), date.month(), date.day()});
+    }
+
+    QElapsedTimer timer;
+    timer.start();
+    const int rangeCount = huangLiDB.queryHuangLiByDays(days).size();
+    const qint64 rangeElapsed = timer.nsecsElapsed();
+
+    timer.restart();
+    int dayCount = 0;
+    foreach (const stDay &day, days) {
+        dayCount += huangLiDB.queryHuangLiByDays(QList<stDay>{day}).size();
+    }
+    const qint64 dayElapsed = timer.nsecsElapsed();
+    qInfo() << "query huangli of" << rangeCount << dayCount << "days, range:" << rangeElapsed / 1000 << "us" << "by day:" << dayElapsed / 1000 << "us";
+}
@@ -0,0 +1,94 @@
+// SPDX-FileCopyrightText: 2019 - 2022 UnionTech Software Technology Co., Ltd.
+//
+// SPDX-License-Identifier: LGPL-3.0-or-later
+
+#include "benchmark.h"
+#include "dschedule.h"
+#include "dschedulequerypar.h"
+#include "doccurrencecache.h"
+
+#include <QElapsedTimer>
+#include <QThreadPool>
+#include <QDebug>
+
+//一年内5000个日程的查询结果分别使用json和二进制格式编码、解码的耗时
+CALENDAR_BENCHMARK(queryResultEncode)
+{
+    const QDateTime dtStart(QDate(2024, 1, 1), QTime(0, 0));
+    const QDateTime dtEnd(QDate(2024, 12, 31), QTime(23, 59));
+    DSchedule::List scheduleList;
+    for (int i = 0; i < 5000; ++i) {
+        DSchedule::Ptr schedule(new DSchedule);
+        schedule->setUid(QString("schedule %1").arg(i));
+        schedule->setSummary(QString("schedule %1").arg(i));
+        schedule->setDtStart(dtStart.addSecs(i * 6300));
+        schedule->setDtEnd(dtStart.addSecs(i * 6300 + 3600));
+        scheduleList.append(schedule);
+    }
+    DScheduleQueryPar::Ptr queryPar(new DScheduleQueryPar);
+    queryPar->setDtStart(dtStart);
+    queryPar->setDtEnd(dtEnd);
+    const QString params = DScheduleQueryPar::toJsonString(queryPar);
+
+    QElapsedTimer timer;
+    timer.start();
+    const QString jsonResult = DSchedule::toListString(params, scheduleList);
+    const qint64 jsonEncodeElapsed = timer.restart();
+    const int jsonDays = DSchedule::fromQueryResult(jsonResult).size();
+    const qint64 jsonDecodeElapsed = timer.restart();
+
+    const QByteArray binaryResult = DSchedule::toListBinary(params, scheduleList);
+    const qint64 binaryEncodeElapsed = timer.restart();
+    const int binaryDays = DSchedule::fromQueryResult(binaryResult).size();
+    const qint64 binaryDecodeElapsed = timer.elapsed();
+
+    qInfo() << "query 5000 schedules in one year, json:" << jsonEncodeElapsed << "+" << jsonDecodeElapsed << "ms,"
+            << jsonResult.toUtf8().size() << "bytes," << jsonDays << "days; binary:"
+            << binaryEncodeElapsed << "+" << binaryDecodeElapsed << "ms,"
+            << binaryResult.size() << "bytes," << binaryDays << "days";
+}
+
+//3000个重复日程展开一年的耗时，分别使用单线程和线程池全部线程，展开前清空实例缓存
+CALENDAR_BENCHMARK(expandOccurrences)
+{
+    DSchedule::List scheduleList;
+    const QDateTime scheduleStart(QDate(2023, 1, 1), QTime(9, 0));
+    for (int i = 0; i < 3000; ++i) {
+        DSchedule::Ptr schedule(new DSchedule);
+        schedule->setSummary(QString("schedule %1").arg(i));
+        schedule->setDtStart(scheduleStart.addSecs(i * 60));
+        schedule->setDtEnd(scheduleStart.addSecs(i * 60 + 3600));
+        switch (i % 3) {
+        case 0:
+            schedule->recurrence()->setDaily(1);
+            break;
+        case 1:
+            schedule->recurrence()->setWeekly(1);
+            break;
+        default:
+            schedule->setLunnar(true);
+            schedule->recurrence()->setMonthly(1);
+            break;
+        }
+        scheduleList.append(schedule);
+    }
+    const QDateTime dtStart(QDate(2024, 1, 1), QTime(0, 0));
+    const QDateTime dtEnd(QDate(2024, 12, 31), QTime(23, 59));
+
+    const int maxThreadCount = QThreadPool::globalInstance()->maxThreadCount();
+    QThreadPool::globalInstance()->setMaxThreadCount(1);
+    DOccurrenceCache::instance()->clear();
+    QElapsedTimer timer;
+    timer.start();
+    const int singleCount = DSchedule::expandOccurrences(scheduleList, dtStart, dtEnd).size();
+    const qint64 singleElapsed = timer.elapsed();
+
+    QThreadPool::globalInstance()->setMaxThreadCount(maxThreadCount);
+    DOccurrenceCache::instance()->clear();
+    timer.restart();
+    const int parallelCount = DSchedule::expandOccurrences(scheduleList, dtStart, dtEnd).size();
+    const qint64 parallelElapsed = timer.elapsed();
+
+    qInfo() << "expand 3000 schedules in one year, 1 thread:" << singleElapsed << "ms," << singleCount << "occurrences;"
+            << maxThreadCount << "threads:" << parallelElapsed << "ms," << parallelCount << "occurrences";
+}
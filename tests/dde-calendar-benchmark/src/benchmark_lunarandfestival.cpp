@@ -0,0 +1,21 @@
+// SPDX-FileCopyrightText: 2019 - 2022 UnionTech Software Technology Co., Ltd.
+//
+// SPDX-License-Identifier: LGPL-3.0-or-later
+
+#include "benchmark.h"
+#include "lunarandfestival/method_interface.h"
+
+#include <QElapsedTimer>
+#include <QDebug>
+
+//计算200年的节气耗时
+CALENDAR_BENCHMARK(get25SolarTermJDs)
+{
+    QElapsedTimer timer;
+    timer.start();
+    double checksum = 0;
+    for (int year = 1900; year < 2100; ++year) {
+        checksum += get25SolarTermJDs(year, DongZhi).last();
+    }
+    qInfo() << "get25SolarTermJDs 200 years:" << timer.elapsed() << "ms" << "checksum:" << QString::number(checksum, 'f', 9);
+}
@@ -0,0 +1,20 @@
+// SPDX-FileCopyrightText: 2019 - 2022 UnionTech Software Technology Co., Ltd.
+//
+// SPDX-License-Identifier: LGPL-3.0-or-later
+
+#include "benchmark.h"
+
+#include <QCoreApplication>
+#include <QDebug>
+
+//用法：dde-calendar-benchmark [名称过滤条件]
+int main(int argc, char **argv)
+{
+    QCoreApplication application(argc, argv);
+    const QString filter = argc > 1 ? QString::fromLocal8Bit(argv[1]) : QString();
+    if (Benchmark::run(filter) == 0) {
+        qWarning() << "no benchmark matches" << filter;
+        return 1;
+    }
+    return 0;
+}
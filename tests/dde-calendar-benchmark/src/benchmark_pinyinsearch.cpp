@@ -0,0 +1,27 @@
+// SPDX-FileCopyrightText: 2019 - 2022 UnionTech Software Technology Co., Ltd.
+//
+// SPDX-License-Identifier: LGPL-3.0-or-later
+
+#include "benchmark.h"
+#include "pinyin/pinyinsearch.h"
+
+#include <QElapsedTimer>
+#include <QDebug>
+
+//第一次查询拼音和逐个生成日程标题拼音的耗时
+CALENDAR_BENCHMARK(createPinyin)
+{
+    pinyinsearch *search = pinyinsearch::getPinPinSearch();
+    QElapsedTimer timer;
+    timer.start();
+    search->CreatePinyin("字");
+    qInfo() << "first pinyin lookup:" << timer.nsecsElapsed() / 1000 << "us";
+
+    const QStringList titles {"团队周会", "和客户讨论需求文档", "提交季度工作总结报告", "下午三点牙医预约", "春节回家的火车票"};
+    int length = 0;
+    timer.restart();
+    for (int i = 0; i < 100000; ++i) {
+        length += search->CreatePinyin(titles.at(i % titles.size())).size();
+    }
+    qInfo() << "create pinyin of 100000 titles:" << timer.elapsed() << "ms," << length << "characters";
+}
@@ -0,0 +1,33 @@
+// SPDX-FileCopyrightText: 2019 - 2022 UnionTech Software Technology Co., Ltd.
+//
+// SPDX-License-Identifier: LGPL-3.0-or-later
+
+#include "benchmark.h"
+#include "schedulelayout.h"
+
+#include <QElapsedTimer>
+#include <QMap>
+#include <QDebug>
+
+//一周500个日程的布局耗时
+CALENDAR_BENCHMARK(scheduleLayout)
+{
+    const QDate beginDate(2023, 5, 8);
+    QMap<QDate, DSchedule::List> weekSchedules;
+    for (int i = 0; i < 500; ++i) {
+        const QDate date = beginDate.addDays(i % 7);
+        const QDateTime dtStart(date, QTime(8, 0).addSecs((i * 37 % 600) * 60));
+        DSchedule::Ptr schedule(new DSchedule);
+        schedule->setDtStart(dtStart);
+        schedule->setDtEnd(dtStart.addSecs((i % 5 + 1) * 30 * 60));
+        weekSchedules[date].append(schedule);
+    }
+
+    QElapsedTimer timer;
+    timer.start();
+    int count = 0;
+    foreach (const DSchedule::List &scheduleList, weekSchedules) {
+        count += CScheduleLayout::layout(scheduleList, 30 * 60).size();
+    }
+    qInfo() << "layout" << count << "schedules in one week:" << timer.nsecsElapsed() / 1000 << "us";
+}
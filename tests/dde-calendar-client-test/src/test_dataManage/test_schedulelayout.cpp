@@ -0,0 +1,94 @@
+// SPDX-FileCopyrightText: 2019 - 2022 UnionTech Software Technology Co., Ltd.
+//
+// SPDX-License-Identifier: LGPL-3.0-or-later
+
+#include "test_schedulelayout.h"
+
+namespace {
+const int MinDuration = 30 * 60;
+}
+
+test_schedulelayout::test_schedulelayout()
+{
+}
+
+DSchedule::Ptr test_schedulelayout::createSchedule(const QDateTime &dtStart, const QDateTime &dtEnd)
+{
+    DSchedule::Ptr schedule(new DSchedule);
+    schedule->setDtStart(dtStart);
+    schedule->setDtEnd(dtEnd);
+    schedule->setSummary(dtStart.toString("hh:mm"));
+    return schedule;
+}
+
+//结束后的列可以被后面的日程复用，组内列数为同时重叠的最大日程数
+TEST_F(test_schedulelayout, layoutReuseColumn)
+{
+    const QDate date(2023, 5, 8);
+    DSchedule::List scheduleList;
+    scheduleList.append(createSchedule(QDateTime(date, QTime(9, 0)), QDateTime(date, QTime(12, 0))));
+    scheduleList.append(createSchedule(QDateTime(date, QTime(9, 30)), QDateTime(date, QTime(10, 0))));
+    scheduleList.append(createSchedule(QDateTime(date, QTime(10, 30)), QDateTime(date, QTime(11, 0))));
+    //开始时间等于上一个日程的结束时间也算重叠
+    scheduleList.append(createSchedule(QDateTime(date, QTime(12, 0)), QDateTime(date, QTime(13, 0))));
+    scheduleList.append(createSchedule(QDateTime(date, QTime(14, 0)), QDateTime(date, QTime(15, 0))));
+
+    const QVector<CScheduleLayout::Item> items = CScheduleLayout::layout(scheduleList, MinDuration);
+    ASSERT_EQ(items.size(), 5);
+    EXPECT_EQ(items.at(0).column, 0);
+    EXPECT_EQ(items.at(1).column, 1);
+    EXPECT_EQ(items.at(2).column, 1);
+    EXPECT_EQ(items.at(3).column, 1);
+    for (int i = 0; i < 4; ++i) {
+        EXPECT_EQ(items.at(i).group, 0);
+        EXPECT_EQ(items.at(i).columnCount, 2);
+    }
+    EXPECT_EQ(items.at(4).group, 1);
+    EXPECT_EQ(items.at(4).column, 0);
+    EXPECT_EQ(items.at(4).columnCount, 1);
+}
+
+//时长不足最小显示时长的日程按最小显示时长计算重叠
+TEST_F(test_schedulelayout, layoutMinDuration)
+{
+    const QDate date(2023, 5, 8);
+    DSchedule::List scheduleList;
+    scheduleList.append(createSchedule(QDateTime(date, QTime(9, 0)), QDateTime(date, QTime(9, 10))));
+    scheduleList.append(createSchedule(QDateTime(date, QTime(9, 20)), QDateTime(date, QTime(9, 25))));
+
+    const QVector<CScheduleLayout::Item> items = CScheduleLayout::layout(scheduleList, MinDuration);
+    ASSERT_EQ(items.size(), 2);
+    EXPECT_EQ(items.at(0).endTime, QDateTime(date, QTime(9, 30)));
+    EXPECT_EQ(items.at(1).column, 1);
+    EXPECT_EQ(items.at(1).columnCount, 2);
+}
+
+//一周500个日程布局后，同一组内重叠的日程不在同一列
+TEST_F(test_schedulelayout, layoutWeekOverlap)
+{
+    const QDate beginDate(2023, 5, 8);
+    QMap<QDate, DSchedule::List> weekSchedules;
+    for (int i = 0; i < 500; ++i) {
+        const QDate date = beginDate.addDays(i % 7);
+        const QDateTime dtStart(date, QTime(8, 0).addSecs((i * 37 % 600) * 60));
+        weekSchedules[date].append(createSchedule(dtStart, dtStart.addSecs((i % 5 + 1) * 30 * 60)));
+    }
+
+    QVector<QVector<CScheduleLayout::Item>> weekItems;
+    foreach (const DSchedule::List &scheduleList, weekSchedules) {
+        weekItems.append(CScheduleLayout::layout(scheduleList, MinDuration));
+    }
+
+    int count = 0;
+    foreach (const QVector<CScheduleLayout::Item> &items, weekItems) {
+        count += items.size();
+        for (int i = 0; i < items.size(); ++i) {
+            EXPECT_LT(items.at(i).column, items.at(i).columnCount);
+            for (int j = i + 1; j < items.size() && items.at(j).beginTime <= items.at(i).endTime; ++j) {
+                EXPECT_EQ(items.at(i).group, items.at(j).group);
+                EXPECT_NE(items.at(i).column, items.at(j).column);
+            }
+        }
+    }
+    EXPECT_EQ(count, 500);
+}
@@ -0,0 +1,20 @@
+// SPDX-FileCopyrightText: 2019 - 2022 UnionTech Software Technology Co., Ltd.
+//
+// SPDX-License-Identifier: LGPL-3.0-or-later
+
+#ifndef TEST_SCHEDULELAYOUT_H
+#define TEST_SCHEDULELAYOUT_H
+
+#include "schedulelayout.h"
+#include "gtest/gtest.h"
+#include <QObject>
+
+class test_schedulelayout : public QObject, public::testing::Test
+{
+public:
+    test_schedulelayout();
+protected:
+    DSchedule::Ptr createSchedule(const QDateTime &dtStart, const QDateTime &dtEnd);
+};
+
+#endif // TEST_SCHEDULELAYOUT_H
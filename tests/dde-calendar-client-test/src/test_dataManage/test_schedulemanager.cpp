@@ -0,0 +1,50 @@
+// SPDX-FileCopyrightText: 2019 - 2022 UnionTech Software Technology Co., Ltd.
+//
+// SPDX-License-Identifier: LGPL-3.0-or-later
+
+#include "test_schedulemanager.h"
+
+test_schedulemanager::test_schedulemanager()
+{
+}
+
+void test_schedulemanager::SetUp()
+{
+    m_scheduleMap = gScheduleManager->m_scheduleMap;
+}
+
+void test_schedulemanager::TearDown()
+{
+    gScheduleManager->m_scheduleMap = m_scheduleMap;
+    gScheduleManager->m_materializedMap.clear();
+}
+
+//同一实例多次获取返回同一日程，不重复复制原日程
+TEST_F(test_schedulemanager, materializedSchedules)
+{
+    const QDateTime dtStart(QDate(2024, 1, 1), QTime(9, 0));
+    DSchedule::Ptr schedule(new DSchedule);
+    schedule->setUid("schedulemanager");
+    schedule->setSummary("schedulemanager");
+    schedule->setDtStart(dtStart);
+    schedule->setDtEnd(dtStart.addSecs(3600));
+    schedule->recurrence()->setDaily(1);
+
+    DScheduleQueryPar::Ptr queryPar(new DScheduleQueryPar);
+    queryPar->setDtStart(dtStart.addDays(-1));
+    queryPar->setDtEnd(dtStart.addDays(7));
+    gScheduleManager->m_scheduleMap = DScheduleOccurrence::toMap(queryPar, DScheduleOccurrence::expand(schedule, queryPar->dtStart(), queryPar->dtEnd()));
+    gScheduleManager->m_materializedMap.clear();
+
+    const QDate date = dtStart.date().addDays(2);
+    DSchedule::List dayList = gScheduleManager->getScheduleByDay(date);
+    ASSERT_EQ(dayList.size(), 1);
+    EXPECT_EQ(dayList.first()->dtStart(), dtStart.addDays(2));
+    EXPECT_EQ(gScheduleManager->getScheduleByDay(date).first(), dayList.first());
+
+    QMap<QDate, DSchedule::List> scheduleMap = gScheduleManager->getScheduleMap(dtStart.date(), dtStart.date().addDays(6));
+    EXPECT_EQ(scheduleMap.size(), 7);
+    EXPECT_EQ(scheduleMap.value(date).first(), dayList.first());
+    EXPECT_EQ(gScheduleManager->getAllScheduleMap().value(date).first(), dayList.first());
+    EXPECT_TRUE(gScheduleManager->getScheduleByDay(dtStart.date().addDays(30)).isEmpty());
+}
@@ -0,0 +1,23 @@
+// SPDX-FileCopyrightText: 2019 - 2022 UnionTech Software Technology Co., Ltd.
+//
+// SPDX-License-Identifier: LGPL-3.0-or-later
+
+#ifndef TEST_SCHEDULEMANAGER_H
+#define TEST_SCHEDULEMANAGER_H
+
+#include "schedulemanager.h"
+#include "gtest/gtest.h"
+#include <QObject>
+
+class test_schedulemanager : public QObject, public::testing::Test
+{
+public:
+    test_schedulemanager();
+    void SetUp() override;
+    void TearDown() override;
+
+protected:
+    DScheduleOccurrence::Map m_scheduleMap;
+};
+
+#endif // TEST_SCHEDULEMANAGER_H
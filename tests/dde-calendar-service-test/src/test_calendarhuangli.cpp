@@ -97,3 +97,36 @@ TEST_F(test_calendarhuangli, GetLunarCalendarMonth)
     fill = true;
     calendarHuangLi->getLunarCalendarMonth(year, month, fill);
 }
+
+//补齐的月数据与缓存的上下月数据一致
+TEST_F(test_calendarhuangli, GetHuangLiMonthFill)
+{
+    CaHuangLiMonthInfo monthInfo;
+    bool isVaild = false;
+    monthInfo.strJsonToInfo(calendarHuangLi->getHuangLiMonth(2021, 1, true), isVaild);
+    ASSERT_TRUE(isVaild);
+    ASSERT_EQ(monthInfo.mCaLunarDayInfo.size(), 42);
+    //2021年1月1日为周五，前面补齐2020年12月最后5天
+    EXPECT_EQ(monthInfo.mFirstDayWeek, 5);
+    EXPECT_EQ(monthInfo.mCaLunarDayInfo.at(0).toJson(), calendarHuangLi->getHuangLiDay(2020, 12, 27));
+    EXPECT_EQ(monthInfo.mCaLunarDayInfo.at(5).toJson(), calendarHuangLi->getHuangLiDay(2021, 1, 1));
+    EXPECT_EQ(monthInfo.mCaLunarDayInfo.at(41).toJson(), calendarHuangLi->getHuangLiDay(2021, 2, 6));
+}
+
+//QString CalendarHuangLi::getHuangLiRange(const QDate &startDate, const QDate &stopDate)
+TEST_F(test_calendarhuangli, GetHuangLiRange)
+{
+    QJsonObject rangeObj = QJsonDocument::fromJson(calendarHuangLi->getHuangLiRange(QDate(2020, 12, 13), QDate(2021, 12, 31)).toUtf8()).object();
+    EXPECT_EQ(rangeObj.value("StartDate").toString(), QString("2020-12-13"));
+    QJsonArray datas = rangeObj.value("Datas").toArray();
+    ASSERT_EQ(datas.size(), 19 + 365);
+    CaHuangLiDayInfo dayInfo;
+    dayInfo.jsonObjectToInfo(datas.at(0).toObject());
+    EXPECT_EQ(dayInfo.toJson(), calendarHuangLi->getHuangLiDay(2020, 12, 13));
+    dayInfo.jsonObjectToInfo(datas.at(datas.size() - 1).toObject());
+    EXPECT_EQ(dayInfo.toJson(), calendarHuangLi->getHuangLiDay(2021, 12, 31));
+
+    //无效范围不返回数据
+    rangeObj = QJsonDocument::fromJson(calendarHuangLi->getHuangLiRange(QDate(2021, 1, 2), QDate(2021, 1, 1)).toUtf8()).object();
+    EXPECT_EQ(rangeObj.value("Days").toInt(), 0);
+}
@@ -0,0 +1,339 @@
+// SPDX-FileCopyrightText: 2019 - 2022 UnionTech Software Technology Co., Ltd.
+//
+// SPDX-License-Identifier: LGPL-3.0-or-later
+
+#include "test_daccountdatabase.h"
+
+#include "calformat.h"
+#include "icalformat.h"
+#include "memorycalendar.h"
+
+#include <QJsonDocument>
+#include <QJsonObject>
+#include <QSqlQuery>
+#include <QTextStream>
+#include <QTimeZone>
+#include <QDebug>
+
+test_daccountdatabase::test_daccountdatabase()
+{
+}
+
+void test_daccountdatabase::SetUp()
+{
+    m_connectionName = DDataBase::createUuid();
+    DAccount::Ptr account(new DAccount(DAccount::Account_Local));
+    account->setAccountID(DDataBase::createUuid());
+    account->setAccountName(m_connectionName);
+    m_accountDB.reset(new DAccountDataBase(account));
+    m_accountDB->setDBPath(m_dir.filePath(m_connectionName + ".db"));
+    m_accountDB->initDBData();
+}
+
+void test_daccountdatabase::TearDown()
+{
+    m_accountDB.reset();
+    QSqlDatabase::removeDatabase(m_connectionName);
+}
+
+DSchedule::Ptr test_daccountdatabase::createSchedule(const QString &summary, int index)
+{
+    const QDateTime dtStart(QDate(2023, 1, 1), QTime(9, 0));
+    DSchedule::Ptr schedule(new DSchedule);
+    schedule->setSummary(summary);
+    schedule->setDescription(QString("description %1").arg(index));
+    schedule->setScheduleTypeID("107c369e-b13a-4d45-9ff3-de4eb3c0475b");
+    schedule->setDtStart(dtStart.addSecs(index * 600));
+    schedule->setDtEnd(dtStart.addSecs(index * 600 + 3600));
+    switch (index % 4) {
+    case 0:
+        schedule->recurrence()->setDaily(1);
+        break;
+    case 1:
+        schedule->recurrence()->setWeekly(1);
+        break;
+    default:
+        break;
+    }
+    if (index % 5 == 0) {
+        KCalendarCore::Alarm::Ptr alarm(new KCalendarCore::Alarm(schedule.data()));
+        alarm->setEnabled(true);
+        alarm->setType(KCalendarCore::Alarm::Display);
+        alarm->setDisplayAlarm(summary);
+        alarm->setStartOffset(KCalendarCore::Duration(-15 * 60));
+        schedule->addAlarm(alarm);
+    }
+    return schedule;
+}
+
+DSchedule::List test_daccountdatabase::createSchedules(int count)
+{
+    DSchedule::List scheduleList;
+    for (int i = 0; i < count; ++i) {
+        scheduleList.append(createSchedule(QString("schedule %1").arg(i), i));
+    }
+    return scheduleList;
+}
+
+bool test_daccountdatabase::execSql(const QString &sql, const QVariantList &values)
+{
+    SqliteQuery query(m_accountDB->m_database);
+    if (!query.prepare(sql)) {
+        return false;
+    }
+    foreach (auto &value, values) {
+        query.addBindValue(value);
+    }
+    return query.exec();
+}
+
+QVariant test_daccountdatabase::queryValue(const QString &sql, const QVariantList &values)
+{
+    SqliteQuery query(m_accountDB->m_database);
+    if (!query.prepare(sql)) {
+        return QVariant();
+    }
+    foreach (auto &value, values) {
+        query.addBindValue(value);
+    }
+    if (!query.exec() || !query.next()) {
+        return QVariant();
+    }
+    return query.value(0);
+}
+
+//二进制缓存有效时直接使用，日程被其他途径修改后缓存过期，重新解析ics并回写缓存
+TEST_F(test_daccountdatabase, scheduleCacheStale)
+{
+    DSchedule::Ptr schedule = createSchedule("cached");
+    const QString scheduleID = m_accountDB->createSchedule(schedule);
+    ASSERT_FALSE(scheduleID.isEmpty());
+    EXPECT_EQ(m_accountDB->getScheduleByScheduleID(scheduleID)->summary(), "cached");
+
+    //只修改ics，修改时间不变时仍使用缓存
+    DSchedule::Ptr changed = createSchedule("changed");
+    changed->setUid(scheduleID);
+    ASSERT_TRUE(execSql("UPDATE schedules SET ics = ? WHERE scheduleID = ?;", {DSchedule::toIcsString(changed), scheduleID}));
+    EXPECT_EQ(m_accountDB->getScheduleByScheduleID(scheduleID)->summary(), "cached");
+
+    //修改时间变化后缓存过期
+    const QString dtUpdate = "2023-02-01T10:00:00";
+    ASSERT_TRUE(execSql("UPDATE schedules SET dtUpdate = ? WHERE scheduleID = ?;", {dtUpdate, scheduleID}));
+    EXPECT_EQ(m_accountDB->getScheduleByScheduleID(scheduleID)->summary(), "changed");
+
+    SqliteQuery query(m_accountDB->m_database);
+    ASSERT_TRUE(query.prepare("SELECT dtUpdate, data FROM scheduleCache WHERE scheduleID = ?;"));
+    query.addBindValue(scheduleID);
+    ASSERT_TRUE(query.exec());
+    ASSERT_TRUE(query.next());
+    EXPECT_EQ(query.value("dtUpdate").toString(), dtUpdate);
+    DSchedule::Ptr cached;
+    ASSERT_TRUE(DSchedule::fromBinary(cached, query.value("data").toByteArray()));
+    EXPECT_EQ(cached->summary(), "changed");
+}
+
+//创建日程时写入的有效时间范围和二进制缓存与日程表的修改时间一致，第一次读取即可命中缓存
+TEST_F(test_daccountdatabase, createScheduleCache)
+{
+    DScheduleCache::Ptr scheduleCache(new DScheduleCache);
+    m_accountDB->setScheduleCache(scheduleCache);
+    DSchedule::List scheduleList = createSchedules(3);
+    const QString scheduleID = m_accountDB->createSchedule(scheduleList.takeFirst());
+    ASSERT_EQ(m_accountDB->createSchedules(scheduleList), 2);
+
+    SqliteQuery query(m_accountDB->m_database);
+    ASSERT_TRUE(query.exec("SELECT COUNT(*) FROM schedules s                                      \
+                           INNER JOIN scheduleCache sc ON sc.scheduleID = s.scheduleID          \
+                           INNER JOIN scheduleSpan sp ON sp.scheduleID = s.scheduleID           \
+                           WHERE s.dtUpdate IS NOT NULL AND sc.dtUpdate = s.dtUpdate AND sp.dtUpdate = s.dtUpdate;"));
+    ASSERT_TRUE(query.next());
+    EXPECT_EQ(query.value(0).toInt(), 3);
+
+    ASSERT_FALSE(m_accountDB->getScheduleByScheduleID(scheduleID).isNull());
+    ASSERT_FALSE(m_accountDB->getScheduleByScheduleID(scheduleID).isNull());
+    QJsonObject statistics = QJsonDocument::fromJson(scheduleCache->toJsonString().toUtf8()).object();
+    EXPECT_EQ(statistics.value("hits").toInt(), 1);
+    EXPECT_EQ(statistics.value("misses").toInt(), 1);
+}
+
+//全文检索表通过触发器与日程表保持一致，包括云同步使用的REPLACE INTO
+TEST_F(test_daccountdatabase, scheduleSearchTriggers)
+{
+    if (!m_accountDB->m_searchEnabled) {
+        qInfo() << "sqlite does not support fts5, skip";
+        return;
+    }
+    const QString countSql = "SELECT (SELECT COUNT(*) FROM scheduleSearch) - (SELECT COUNT(*) FROM schedules);";
+    DSchedule::Ptr schedule = createSchedule("项目周会讨论");
+    schedule->setDescription("准备季度报告");
+    const QString scheduleID = m_accountDB->createSchedule(schedule);
+    ASSERT_FALSE(scheduleID.isEmpty());
+    m_accountDB->createSchedule(createSchedule("其他日程", 1));
+    EXPECT_EQ(queryValue(countSql).toInt(), 0);
+    EXPECT_EQ(m_accountDB->querySchedulesByKey("周会讨").size(), 1);
+    EXPECT_EQ(m_accountDB->querySchedulesByKey("季度报告").size(), 1);
+
+    //修改标题
+    schedule = m_accountDB->getScheduleByScheduleID(scheduleID);
+    schedule->setSummary("年度总结大会");
+    ASSERT_TRUE(m_accountDB->updateSchedule(schedule));
+    EXPECT_EQ(queryValue(countSql).toInt(), 0);
+    EXPECT_EQ(m_accountDB->querySchedulesByKey("周会讨").size(), 0);
+    EXPECT_EQ(m_accountDB->querySchedulesByKey("总结大会").size(), 1);
+
+    //REPLACE INTO会删除原有的行，不会触发删除触发器
+    ASSERT_TRUE(execSql("REPLACE INTO schedules (scheduleID, scheduleTypeID, summary, description, allDay, dtStart, dtEnd,  \
+                        isAlarm, titlePinyin, isLunar, ics, fileName, dtCreate, dtUpdate, dtDelete, isDeleted)             \
+                        SELECT scheduleID, scheduleTypeID, '同步后的标题', '', allDay, dtStart, dtEnd,                    \
+                        isAlarm, titlePinyin, isLunar, ics, fileName, dtCreate, dtUpdate, dtDelete, isDeleted              \
+                        FROM schedules WHERE scheduleID = ?;", {scheduleID}));
+    EXPECT_EQ(queryValue(countSql).toInt(), 0);
+    EXPECT_EQ(queryValue("SELECT COUNT(*) FROM scheduleSearch WHERE scheduleSearch MATCH ?;", {"\"总结大会\""}).toInt(), 0);
+    EXPECT_EQ(queryValue("SELECT COUNT(*) FROM scheduleSearch WHERE scheduleSearch MATCH ?;", {"\"季度报告\""}).toInt(), 0);
+    const QString searchSql = "SELECT s.scheduleID FROM scheduleSearch ss                                      \
+                              INNER JOIN scheduleSearchRow sr ON sr.searchID = ss.rowid                     \
+                              INNER JOIN schedules s ON s.scheduleID = sr.scheduleID                        \
+                              WHERE scheduleSearch MATCH ?;";
+    EXPECT_EQ(queryValue(searchSql, {"\"同步后的标题\""}).toString(), scheduleID);
+
+    //VACUUM后schedules表的rowid可能变化，检索结果仍对应原日程
+    ASSERT_TRUE(execSql("DELETE FROM schedules WHERE summary = ?;", {"其他日程"}));
+    ASSERT_TRUE(execSql("VACUUM;"));
+    EXPECT_EQ(queryValue(searchSql, {"\"同步后的标题\""}).toString(), scheduleID);
+    EXPECT_EQ(queryValue("SELECT (SELECT COUNT(*) FROM scheduleSearchRow) - (SELECT COUNT(*) FROM schedules);").toInt(), 0);
+
+    //删除日程
+    ASSERT_TRUE(m_accountDB->deleteScheduleByScheduleID(scheduleID, 1));
+    EXPECT_EQ(queryValue(countSql).toInt(), 0);
+    EXPECT_EQ(queryValue("SELECT COUNT(*) FROM scheduleSearchRow WHERE scheduleID = ?;", {scheduleID}).toInt(), 0);
+    EXPECT_EQ(queryValue("SELECT COUNT(*) FROM scheduleSearch WHERE scheduleSearch MATCH ?;", {"\"同步后的标题\""}).toInt(), 0);
+}
+
+//关键字去掉首尾空白后查询，包含引号的关键字按普通字符匹配
+TEST_F(test_daccountdatabase, scheduleSearchKey)
+{
+    if (!m_accountDB->m_searchEnabled) {
+        qInfo() << "sqlite does not support fts5, skip";
+        return;
+    }
+    DSchedule::Ptr schedule = createSchedule("讨论\"季度\"报告");
+    ASSERT_FALSE(m_accountDB->createSchedule(schedule).isEmpty());
+    m_accountDB->createSchedule(createSchedule("其他日程", 1));
+
+    EXPECT_EQ(m_accountDB->querySchedulesByKey("  季度\"报告 ").size(), 1);
+    EXPECT_EQ(m_accountDB->querySchedulesByKey(" 讨论\" ").size(), 1);
+    EXPECT_EQ(m_accountDB->querySchedulesByKey("\"季度 报告\"").size(), 0);
+    EXPECT_EQ(m_accountDB->querySchedulesByKey(" 其他 ").size(), 1);
+}
+
+//嵌套的批量写入合并到外层事务中，外层回滚时清理和写入都被撤销
+TEST_F(test_daccountdatabase, transactionRollback)
+{
+    const QString typeID = "107c369e-b13a-4d45-9ff3-de4eb3c0475b";
+    const QString scheduleID = m_accountDB->createSchedule(createSchedule("existing"));
+    ASSERT_FALSE(scheduleID.isEmpty());
+
+    m_accountDB->transaction();
+    ASSERT_TRUE(m_accountDB->deleteSchedulesByScheduleTypeID(typeID, 1));
+    ASSERT_EQ(m_accountDB->createSchedules(createSchedules(3)), 3);
+    m_accountDB->rollback();
+
+    EXPECT_EQ(m_accountDB->getScheduleIDListByTypeID(typeID), QStringList() << scheduleID);
+    EXPECT_EQ(queryValue("SELECT COUNT(*) FROM scheduleSpan;").toInt(), 1);
+    EXPECT_EQ(queryValue("SELECT COUNT(*) FROM scheduleCache;").toInt(), 1);
+
+    m_accountDB->transaction();
+    ASSERT_TRUE(m_accountDB->deleteSchedulesByScheduleTypeID(typeID, 1));
+    ASSERT_EQ(m_accountDB->createSchedules(createSchedules(3)), 3);
+    m_accountDB->commit();
+    EXPECT_EQ(m_accountDB->getScheduleIDListByTypeID(typeID).size(), 3);
+    EXPECT_FALSE(m_accountDB->getScheduleIDListByTypeID(typeID).contains(scheduleID));
+}
+
+//导出超过一个导入批次的日程时，时区写在第一个日程之前，后续批次解析时同样能找到时区
+TEST_F(test_daccountdatabase, exportSchedulesTimezone)
+{
+    const QString typeID = "107c369e-b13a-4d45-9ff3-de4eb3c0475b";
+    const int count = 600;
+    const int batchSize = 500;
+    const QTimeZone timezone("America/New_York");
+    const QDateTime dtStart(QDate(2023, 1, 1), QTime(9, 0), timezone);
+    DSchedule::List scheduleList;
+    for (int i = 0; i < count; ++i) {
+        DSchedule::Ptr schedule(new DSchedule);
+        schedule->setSummary(QString("schedule %1").arg(i));
+        schedule->setScheduleTypeID(typeID);
+        schedule->setDtStart(dtStart.addSecs(i * 600));
+        schedule->setDtEnd(dtStart.addSecs(i * 600 + 3600));
+        scheduleList.append(schedule);
+    }
+    ASSERT_EQ(m_accountDB->createSchedules(scheduleList), count);
+
+    QString ics;
+    QTextStream stream(&ics);
+    stream << "BEGIN:VCALENDAR\r\nPRODID:" << KCalendarCore::CalFormat::productId() << "\r\nVERSION:2.0\r\n";
+    ASSERT_TRUE(m_accountDB->exportSchedulesByTypeID(typeID, stream));
+    stream << "END:VCALENDAR\r\n";
+    stream.flush();
+    const int firstEvent = ics.indexOf("BEGIN:VEVENT");
+    ASSERT_GT(firstEvent, 0);
+    EXPECT_EQ(ics.count("BEGIN:VTIMEZONE"), 1);
+    EXPECT_LT(ics.indexOf("BEGIN:VTIMEZONE"), firstEvent);
+
+    //与导入时相同，第二个批次只包含日程之前的内容和剩余的日程
+    int batchStart = firstEvent;
+    for (int i = 0; i < batchSize; ++i) {
+        batchStart = ics.indexOf("BEGIN:VEVENT", batchStart + 1);
+    }
+    ASSERT_GT(batchStart, firstEvent);
+    const QString batch = ics.left(firstEvent) + ics.mid(batchStart);
+    KCalendarCore::MemoryCalendar::Ptr cal(new KCalendarCore::MemoryCalendar(QTimeZone::utc()));
+    ASSERT_TRUE(KCalendarCore::ICalFormat().fromString(cal, batch));
+    ASSERT_EQ(cal->events().size(), count - batchSize);
+    foreach (auto &event, cal->events()) {
+        EXPECT_EQ(event->dtStart().timeZone().id(), timezone.id());
+    }
+}
+
+//在外层事务中补全有效时间范围，同一线程不会重复加锁
+TEST_F(test_daccountdatabase, refreshScheduleSpanInTransaction)
+{
+    ASSERT_EQ(m_accountDB->createSchedules(createSchedules(3)), 3);
+    ASSERT_TRUE(execSql("DELETE FROM scheduleSpan;"));
+
+    m_accountDB->transaction();
+    m_accountDB->refreshScheduleSpan();
+    m_accountDB->commit();
+    EXPECT_EQ(queryValue("SELECT COUNT(*) FROM scheduleSpan;").toInt(), 3);
+}
+
+//在外层事务中补全和更新下一次提醒时间，同一线程不会重复加锁
+TEST_F(test_daccountdatabase, refreshScheduleAlarmInTransaction)
+{
+    const QString typeID = "107c369e-b13a-4d45-9ff3-de4eb3c0475b";
+    ASSERT_EQ(m_accountDB->createSchedules(createSchedules(10)), 10);
+    const int alarmCount = queryValue("SELECT COUNT(*) FROM schedules WHERE isAlarm = 1;").toInt();
+    ASSERT_GT(alarmCount, 0);
+    ASSERT_TRUE(execSql("DELETE FROM scheduleAlarm;"));
+
+    m_accountDB->transaction();
+    m_accountDB->refreshScheduleAlarm();
+    m_accountDB->commit();
+    EXPECT_EQ(queryValue("SELECT COUNT(*) FROM scheduleAlarm;").toInt(), alarmCount);
+
+    //重复日程以一个月后为起点，下一次提醒时间发生变化
+    DSchedule::List scheduleList;
+    foreach (auto &scheduleID, m_accountDB->getScheduleIDListByTypeID(typeID)) {
+        DSchedule::Ptr schedule = m_accountDB->getScheduleByScheduleID(scheduleID);
+        if (schedule->hasEnabledAlarms()) {
+            scheduleList.append(schedule);
+        }
+    }
+    ASSERT_EQ(scheduleList.size(), alarmCount);
+    const QString nextAlarmSql = "SELECT nextAlarm FROM scheduleAlarm WHERE scheduleID = ?;";
+    const QVariant nextAlarm = queryValue(nextAlarmSql, {scheduleList.first()->schedulingID()});
+    m_accountDB->transaction();
+    m_accountDB->updateNextAlarm(scheduleList, QDateTime(QDate(2023, 2, 1), QTime(0, 0)));
+    m_accountDB->commit();
+    EXPECT_NE(queryValue(nextAlarmSql, {scheduleList.first()->schedulingID()}), nextAlarm);
+}
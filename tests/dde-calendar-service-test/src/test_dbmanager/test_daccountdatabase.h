@@ -0,0 +1,37 @@
+// SPDX-FileCopyrightText: 2019 - 2022 UnionTech Software Technology Co., Ltd.
+//
+// SPDX-License-Identifier: LGPL-3.0-or-later
+
+#ifndef TEST_DACCOUNTDATABASE_H
+#define TEST_DACCOUNTDATABASE_H
+
+#include "daccountdatabase.h"
+#include "gtest/gtest.h"
+#include <QObject>
+#include <QTemporaryDir>
+
+class test_daccountdatabase : public QObject, public::testing::Test
+{
+public:
+    test_daccountdatabase();
+
+    //每个用例使用临时目录中新建的帐户数据库
+    virtual void SetUp();
+    virtual void TearDown();
+
+protected:
+    //创建日程，按序号设置重复规则和提醒
+    DSchedule::Ptr createSchedule(const QString &summary, int index = 0);
+    DSchedule::List createSchedules(int count);
+    //直接执行sql语句，模拟云同步等不经过DAccountDataBase的写入
+    bool execSql(const QString &sql, const QVariantList &values = QVariantList());
+    //获取查询结果第一行第一列的值
+    QVariant queryValue(const QString &sql, const QVariantList &values = QVariantList());
+
+protected:
+    QTemporaryDir m_dir;
+    QString m_connectionName;
+    DAccountDataBase::Ptr m_accountDB;
+};
+
+#endif // TEST_DACCOUNTDATABASE_H
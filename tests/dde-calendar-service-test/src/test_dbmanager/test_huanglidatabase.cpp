@@ -5,6 +5,10 @@
 #include "test_huanglidatabase.h"
 #include "../third-party_stub/stub.h"
 #include "config.h"
+#include "dbmanager/dhuanglidatabase.h"
+
+#include <QFile>
+#include <QDebug>
 
 bool stub_OpenHuangliDatabase(void *obj, const QString &dbpath)
 {
@@ -74,6 +78,64 @@ TEST_F(test_huanglidatabase, QueryHuangLiByDays)
     assert(hl2Suit == hl2.Suit && hl2Avoid == hl2.Avoid);
 }
 
+//使用源码中的黄历数据库，不依赖安装后的文件
+static bool openSourceHuangLiDataBase(DHuangLiDataBase &huangLiDB)
+{
+    if (!QFile::exists(HL_DATABASE_DIR)) {
+        return false;
+    }
+    huangLiDB.m_database.close();
+    huangLiDB.m_database.setDatabaseName(HL_DATABASE_DIR);
+    return huangLiDB.m_database.open();
+}
+
+//一年的黄历信息一次范围查询与逐天查询结果一致
+TEST(test_dhuanglidatabase, QueryHuangLiByDaysRange)
+{
+    DHuangLiDataBase huangLiDB;
+    if (!openSourceHuangLiDataBase(huangLiDB)) {
+        GTEST_SKIP() << "can not open " << HL_DATABASE_DIR;
+    }
+    QList<stDay> days;
+    for (QDate date(2021, 1, 1); date.year() == 2021; date = date.addDays(1)) {
+        days.append(stDay{date.year(), date.month(), date.day()});
+    }
+
+    QList<stHuangLi> rangeList = huangLiDB.queryHuangLiByDays(days);
+    QList<stHuangLi> dayList;
+    foreach (const stDay &day, days) {
+        dayList.append(huangLiDB.queryHuangLiByDays(QList<stDay>{day}));
+    }
+
+    ASSERT_EQ(365, rangeList.size());
+    ASSERT_EQ(365, dayList.size());
+    for (int i = 0; i < rangeList.size(); ++i) {
+        EXPECT_EQ(rangeList.at(i).ID, dayList.at(i).ID);
+        EXPECT_EQ(rangeList.at(i).Suit, dayList.at(i).Suit);
+        EXPECT_EQ(rangeList.at(i).Avoid, dayList.at(i).Avoid);
+    }
+    EXPECT_EQ(20210101, rangeList.first().ID);
+    EXPECT_EQ(20211231, rangeList.last().ID);
+    EXPECT_FALSE(rangeList.first().Suit.isEmpty());
+}
+
+//按年查询的节假日与逐月查询的结果一致
+TEST(test_dhuanglidatabase, QueryFestivalListByYear)
+{
+    DHuangLiDataBase huangLiDB;
+    QJsonArray monthList;
+    for (quint8 month = 1; month <= 12; ++month) {
+        for (auto val : huangLiDB.queryFestivalList(2024, month)) {
+            EXPECT_EQ(month, QDate::fromString(val.toObject().value("date").toString(), "yyyy-MM-dd").month());
+            monthList.append(val);
+        }
+    }
+    QJsonArray yearList = huangLiDB.queryFestivalList(2024);
+    EXPECT_FALSE(yearList.isEmpty());
+    EXPECT_EQ(monthList.size(), yearList.size());
+    EXPECT_TRUE(huangLiDB.queryFestivalList(2024, 13).isEmpty());
+}
+
 ////bool HuangLiDataBase::OpenHuangliDatabase(const QString &dbpath)
 //TEST_F(test_huanglidatabase, OpenHuangliDatabase)
 //{
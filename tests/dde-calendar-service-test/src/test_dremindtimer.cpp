@@ -0,0 +1,36 @@
+// SPDX-FileCopyrightText: 2019 - 2022 UnionTech Software Technology Co., Ltd.
+//
+// SPDX-License-Identifier: LGPL-3.0-or-later
+
+#include "test_dremindtimer.h"
+
+#include <QDateTime>
+#include <QDebug>
+
+test_dremindtimer::test_dremindtimer()
+{
+}
+
+//使用空的提醒任务替换时清空帐户下的任务，并释放对程序退出的阻止
+TEST_F(test_dremindtimer, setEmptyRemindJobs)
+{
+    DRemindTimer *remindTimer = DRemindTimer::instance();
+    if (!remindTimer->isValid()) {
+        qInfo() << "timerfd unavailable, skip";
+        return;
+    }
+    const QString accountID = "test_dremindtimer";
+    SystemDInfo info;
+    info.accountID = accountID;
+    info.alarmID = "alarm";
+    info.laterCount = 0;
+    info.triggerTimer = QDateTime::currentDateTime().addDays(1);
+    const int count = remindTimer->count();
+    remindTimer->setRemindJobs(accountID, QVector<SystemDInfo>() << info);
+    EXPECT_EQ(remindTimer->count(), count + 1);
+    EXPECT_TRUE(remindTimer->m_holdExit);
+
+    remindTimer->setRemindJobs(accountID, QVector<SystemDInfo>());
+    EXPECT_EQ(remindTimer->count(), count);
+    EXPECT_EQ(remindTimer->m_holdExit, count > 0);
+}
@@ -0,0 +1,18 @@
+// SPDX-FileCopyrightText: 2019 - 2022 UnionTech Software Technology Co., Ltd.
+//
+// SPDX-License-Identifier: LGPL-3.0-or-later
+
+#ifndef TEST_DREMINDTIMER_H
+#define TEST_DREMINDTIMER_H
+
+#include "dremindtimer.h"
+#include "gtest/gtest.h"
+#include <QObject>
+
+class test_dremindtimer : public QObject, public::testing::Test
+{
+public:
+    test_dremindtimer();
+};
+
+#endif // TEST_DREMINDTIMER_H
@@ -0,0 +1,201 @@
+// SPDX-FileCopyrightText: 2019 - 2022 UnionTech Software Technology Co., Ltd.
+//
+// SPDX-License-Identifier: LGPL-3.0-or-later
+
+#include "test_dschedule.h"
+#include "doccurrencecache.h"
+
+#include <QThreadPool>
+#include <QElapsedTimer>
+
+test_dschedule::test_dschedule()
+{
+}
+
+DSchedule::List test_dschedule::createRecurSchedules(int count)
+{
+    DSchedule::List scheduleList;
+    const QDateTime dtStart(QDate(2023, 1, 1), QTime(9, 0));
+    for (int i = 0; i < count; ++i) {
+        DSchedule::Ptr schedule(new DSchedule);
+        schedule->setSummary(QString("schedule %1").arg(i));
+        schedule->setDtStart(dtStart.addSecs(i * 60));
+        schedule->setDtEnd(dtStart.addSecs(i * 60 + 3600));
+        switch (i % 3) {
+        case 0:
+            schedule->recurrence()->setDaily(1);
+            break;
+        case 1:
+            schedule->recurrence()->setWeekly(1);
+            break;
+        default:
+            schedule->setLunnar(true);
+            schedule->recurrence()->setMonthly(1);
+            break;
+        }
+        scheduleList.append(schedule);
+    }
+    return scheduleList;
+}
+
+//并行展开的结果与逐个展开的结果顺序一致
+TEST_F(test_dschedule, expandOccurrencesOrder)
+{
+    DSchedule::List scheduleList = createRecurSchedules(300);
+    const QDateTime dtStart(QDate(2024, 1, 1), QTime(0, 0));
+    const QDateTime dtEnd(QDate(2024, 3, 31), QTime(23, 59));
+
+    DSchedule::List expected;
+    foreach (auto &schedule, scheduleList) {
+        expected.append(DSchedule::expandOccurrences(schedule, dtStart, dtEnd));
+    }
+    DSchedule::List occurrences = DSchedule::expandOccurrences(scheduleList, dtStart, dtEnd);
+    ASSERT_EQ(expected.size(), occurrences.size());
+    for (int i = 0; i < expected.size(); ++i) {
+        EXPECT_EQ(expected.at(i)->uid(), occurrences.at(i)->uid());
+        EXPECT_EQ(expected.at(i)->dtStart(), occurrences.at(i)->dtStart());
+    }
+}
+
+//单线程和线程池全部线程展开的结果一致
+TEST_F(test_dschedule, expandOccurrencesParallel)
+{
+    DSchedule::List scheduleList = createRecurSchedules(300);
+    const QDateTime dtStart(QDate(2024, 1, 1), QTime(0, 0));
+    const QDateTime dtEnd(QDate(2024, 12, 31), QTime(23, 59));
+
+    const int maxThreadCount = QThreadPool::globalInstance()->maxThreadCount();
+    QThreadPool::globalInstance()->setMaxThreadCount(1);
+    DOccurrenceCache::instance()->clear();
+    const DSchedule::List singleList = DSchedule::expandOccurrences(scheduleList, dtStart, dtEnd);
+
+    QThreadPool::globalInstance()->setMaxThreadCount(maxThreadCount);
+    DOccurrenceCache::instance()->clear();
+    const DSchedule::List parallelList = DSchedule::expandOccurrences(scheduleList, dtStart, dtEnd);
+
+    ASSERT_EQ(singleList.size(), parallelList.size());
+    EXPECT_GT(parallelList.size(), 300);
+    for (int i = 0; i < singleList.size(); ++i) {
+        EXPECT_EQ(singleList.at(i)->summary(), parallelList.at(i)->summary());
+        EXPECT_EQ(singleList.at(i)->dtStart(), parallelList.at(i)->dtStart());
+    }
+}
+
+//重复展开相同范围时使用缓存的实例时间，修改重复规则后重新计算
+TEST_F(test_dschedule, expandOccurrencesCache)
+{
+    DSchedule::List scheduleList = createRecurSchedules(3);
+    const QDateTime dtStart(QDate(2024, 1, 1), QTime(0, 0));
+    const QDateTime dtEnd(QDate(2024, 1, 31), QTime(23, 59));
+    DOccurrenceCache::instance()->clear();
+
+    const qint64 misses = DOccurrenceCache::instance()->toJsonObject().value("misses").toVariant().toLongLong();
+    DSchedule::List occurrences = DSchedule::expandOccurrences(scheduleList.first(), dtStart, dtEnd);
+    EXPECT_EQ(occurrences.size(), 31);
+    QJsonObject statistics = DOccurrenceCache::instance()->toJsonObject();
+    EXPECT_EQ(statistics.value("misses").toVariant().toLongLong(), misses + 1);
+
+    //重新解析的日程与原日程内容相同，命中缓存
+    DSchedule::Ptr parsed;
+    ASSERT_TRUE(DSchedule::fromBinary(parsed, DSchedule::toBinary(scheduleList.first())));
+    const qint64 hits = statistics.value("hits").toVariant().toLongLong();
+    DSchedule::List cachedOccurrences = DSchedule::expandOccurrences(parsed, dtStart, dtEnd);
+    EXPECT_EQ(DOccurrenceCache::instance()->toJsonObject().value("hits").toVariant().toLongLong(), hits + 1);
+    ASSERT_EQ(cachedOccurrences.size(), occurrences.size());
+    for (int i = 0; i < occurrences.size(); ++i) {
+        EXPECT_EQ(cachedOccurrences.at(i)->dtStart(), occurrences.at(i)->dtStart());
+    }
+
+    parsed->recurrence()->setDaily(2);
+    EXPECT_EQ(DSchedule::expandOccurrences(parsed, dtStart, dtEnd).size(), 15);
+}
+
+//命中缓存时只生成缓存键并读取实例时间，耗时低于展开重复规则
+TEST_F(test_dschedule, occurrenceCacheHitCost)
+{
+    DSchedule::Ptr schedule = createRecurSchedules(1).first();
+    for (int i = 0; i < 20; ++i) {
+        schedule->recurrence()->addExDateTime(schedule->dtStart().addDays(400 + i * 7));
+    }
+    const QDateTime dtStart(QDate(2024, 1, 1), QTime(0, 0));
+    const QDateTime dtEnd(QDate(2024, 12, 31), QTime(23, 59));
+    //重复规则自带缓存，每次展开都使用重新解析的日程
+    const int count = 50;
+    const QByteArray data = DSchedule::toBinary(schedule);
+    DSchedule::List scheduleList;
+    for (int i = 0; i < count; ++i) {
+        DSchedule::Ptr parsed;
+        ASSERT_TRUE(DSchedule::fromBinary(parsed, data));
+        scheduleList.append(parsed);
+    }
+
+    DOccurrenceCache cache;
+    QElapsedTimer timer;
+    timer.start();
+    QList<QDateTime> expandList;
+    foreach (auto &parsed, scheduleList) {
+        expandList = parsed->recurrence()->timesInInterval(dtStart, dtEnd);
+    }
+    const qint64 expandElapsed = timer.nsecsElapsed();
+    ASSERT_EQ(expandList.size(), 346);
+    cache.insert(DOccurrenceCache::cacheKey(*scheduleList.first(), dtStart, dtEnd), expandList);
+
+    timer.restart();
+    QList<QDateTime> cacheList;
+    foreach (auto &parsed, scheduleList) {
+        ASSERT_TRUE(cache.value(DOccurrenceCache::cacheKey(*parsed, dtStart, dtEnd), cacheList));
+    }
+    const qint64 hitElapsed = timer.nsecsElapsed();
+    EXPECT_EQ(cacheList, expandList);
+    EXPECT_LT(hitElapsed, expandElapsed);
+}
+
+//不同进程可以设置不同的缓存容量
+TEST_F(test_dschedule, occurrenceCacheMaxCost)
+{
+    DOccurrenceCache cache;
+    const int defaultCost = cache.toJsonObject().value("capacity").toInt();
+    cache.setMaxCost(10);
+    EXPECT_EQ(cache.toJsonObject().value("capacity").toInt(), 10);
+    EXPECT_LT(10, defaultCost);
+    //超过容量的实例时间不会被缓存
+    QList<QDateTime> dtList;
+    for (int i = 0; i < 10; ++i) {
+        dtList.append(QDateTime(QDate(2024, 1, 1 + i), QTime(9, 0)));
+    }
+    cache.insert("key", dtList);
+    EXPECT_FALSE(cache.value("key", dtList));
+}
+
+//查询结果使用json和二进制格式时，按日期归类的结果一致
+TEST_F(test_dschedule, queryResultBinary)
+{
+    const QDateTime dtStart(QDate(2024, 1, 1), QTime(0, 0));
+    const QDateTime dtEnd(QDate(2024, 12, 31), QTime(23, 59));
+    DSchedule::List scheduleList;
+    for (int i = 0; i < 50; ++i) {
+        DSchedule::Ptr schedule(new DSchedule);
+        schedule->setUid(QString("schedule %1").arg(i));
+        schedule->setSummary(QString("schedule %1").arg(i));
+        schedule->setDtStart(dtStart.addSecs(i * 63000));
+        schedule->setDtEnd(dtStart.addSecs(i * 63000 + 3600));
+        scheduleList.append(schedule);
+    }
+    DScheduleQueryPar::Ptr queryPar(new DScheduleQueryPar);
+    queryPar->setDtStart(dtStart);
+    queryPar->setDtEnd(dtEnd);
+    const QString params = DScheduleQueryPar::toJsonString(queryPar);
+
+    QMap<QDate, DSchedule::List> jsonMap = DSchedule::fromQueryResult(DSchedule::toListString(params, scheduleList));
+    QMap<QDate, DSchedule::List> binaryMap = DSchedule::fromQueryResult(DSchedule::toListBinary(params, scheduleList));
+    ASSERT_FALSE(jsonMap.isEmpty());
+    ASSERT_EQ(jsonMap.keys(), binaryMap.keys());
+    for (auto iter = jsonMap.constBegin(); iter != jsonMap.constEnd(); ++iter) {
+        const DSchedule::List &binaryList = binaryMap.value(iter.key());
+        ASSERT_EQ(iter.value().size(), binaryList.size());
+        for (int i = 0; i < binaryList.size(); ++i) {
+            EXPECT_EQ(iter.value().at(i)->uid(), binaryList.at(i)->uid());
+            EXPECT_EQ(iter.value().at(i)->dtStart(), binaryList.at(i)->dtStart());
+        }
+    }
+}
@@ -0,0 +1,21 @@
+// SPDX-FileCopyrightText: 2019 - 2022 UnionTech Software Technology Co., Ltd.
+//
+// SPDX-License-Identifier: LGPL-3.0-or-later
+
+#ifndef TEST_DSCHEDULE_H
+#define TEST_DSCHEDULE_H
+
+#include "dschedule.h"
+#include "gtest/gtest.h"
+#include <QObject>
+
+class test_dschedule : public QObject, public::testing::Test
+{
+public:
+    test_dschedule();
+protected:
+    //创建重复日程，按序号交替使用每天、每周和农历每月重复
+    DSchedule::List createRecurSchedules(int count);
+};
+
+#endif // TEST_DSCHEDULE_H
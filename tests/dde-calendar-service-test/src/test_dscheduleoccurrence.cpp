@@ -0,0 +1,137 @@
+// SPDX-FileCopyrightText: 2019 - 2022 UnionTech Software Technology Co., Ltd.
+//
+// SPDX-License-Identifier: LGPL-3.0-or-later
+
+#include "test_dscheduleoccurrence.h"
+
+#include <QDebug>
+
+#ifdef __GLIBC__
+#include <malloc.h>
+#endif
+
+namespace {
+//当前堆内存使用量，用于比较两种实例保存方式的内存占用
+qint64 heapUsed()
+{
+#ifdef __GLIBC__
+#if __GLIBC_PREREQ(2, 33)
+    return static_cast<qint64>(mallinfo2().uordblks);
+#else
+    return mallinfo().uordblks;
+#endif
+#else
+    return 0;
+#endif
+}
+} // namespace
+
+test_dscheduleoccurrence::test_dscheduleoccurrence()
+{
+}
+
+DSchedule::Ptr test_dscheduleoccurrence::createDailySchedule(const QString &summary)
+{
+    DSchedule::Ptr schedule(new DSchedule);
+    schedule->setSummary(summary);
+    schedule->setDtStart(QDateTime(QDate(2023, 1, 1), QTime(9, 0)));
+    schedule->setDtEnd(QDateTime(QDate(2023, 1, 1), QTime(10, 0)));
+    schedule->recurrence()->setDaily(1);
+    return schedule;
+}
+
+//生成的完整日程与直接展开的日程一致
+TEST_F(test_dscheduleoccurrence, toSchedule)
+{
+    DSchedule::Ptr schedule = createDailySchedule("daily");
+    const QDateTime dtStart(QDate(2022, 12, 30), QTime(0, 0));
+    const QDateTime dtEnd(QDate(2023, 1, 10), QTime(23, 59));
+
+    DScheduleOccurrence::List occurrences = DScheduleOccurrence::expand(schedule, dtStart, dtEnd);
+    DSchedule::List schedules = DSchedule::expandOccurrences(schedule, dtStart, dtEnd);
+    ASSERT_EQ(occurrences.size(), 10);
+    ASSERT_EQ(occurrences.size(), schedules.size());
+    for (int i = 0; i < occurrences.size(); ++i) {
+        EXPECT_EQ(occurrences.at(i).master(), schedule);
+        DSchedule::Ptr occurrence = occurrences.at(i).toSchedule();
+        EXPECT_EQ(occurrence->dtStart(), schedules.at(i)->dtStart());
+        EXPECT_EQ(occurrence->dtEnd(), schedules.at(i)->dtEnd());
+        EXPECT_EQ(occurrence->instanceIdentifier(), schedules.at(i)->instanceIdentifier());
+    }
+    //第一次重复与原日程时间一致，不设置RecurrenceId
+    EXPECT_FALSE(occurrences.first().recurrenceId().isValid());
+    EXPECT_EQ(occurrences.at(1).recurrenceId(), QDateTime(QDate(2023, 1, 2), QTime(9, 0)));
+
+    //普通日程直接返回原日程
+    DSchedule::Ptr single(new DSchedule);
+    single->setDtStart(QDateTime(QDate(2023, 1, 5), QTime(9, 0)));
+    single->setDtEnd(QDateTime(QDate(2023, 1, 5), QTime(10, 0)));
+    DScheduleOccurrence::List singleOccurrences = DScheduleOccurrence::expand(single, dtStart, dtEnd);
+    ASSERT_EQ(singleOccurrences.size(), 1);
+    EXPECT_EQ(singleOccurrences.first().toSchedule(), single);
+}
+
+//二进制格式中原日程只保存一次
+TEST_F(test_dscheduleoccurrence, listBinary)
+{
+    DSchedule::List scheduleList;
+    scheduleList.append(createDailySchedule("daily"));
+    DSchedule::Ptr single(new DSchedule);
+    single->setSummary("single");
+    single->setDtStart(QDateTime(QDate(2023, 3, 1), QTime(9, 0)));
+    single->setDtEnd(QDateTime(QDate(2023, 3, 3), QTime(10, 0)));
+    scheduleList.append(single);
+
+    DScheduleQueryPar::Ptr queryPar(new DScheduleQueryPar);
+    queryPar->setDtStart(QDateTime(QDate(2023, 3, 1), QTime(0, 0)));
+    queryPar->setDtEnd(QDateTime(QDate(2023, 3, 31), QTime(23, 59)));
+    const QString query = DScheduleQueryPar::toJsonString(queryPar);
+
+    DScheduleOccurrence::List occurrences = DScheduleOccurrence::expand(scheduleList, queryPar->dtStart(), queryPar->dtEnd());
+    ASSERT_EQ(occurrences.size(), 32);
+    QPair<QString, DScheduleOccurrence::List> pair = DScheduleOccurrence::fromListBinary(DScheduleOccurrence::toListBinary(query, occurrences));
+    EXPECT_EQ(pair.first, query);
+    ASSERT_EQ(pair.second.size(), occurrences.size());
+    for (int i = 0; i < occurrences.size(); ++i) {
+        EXPECT_EQ(pair.second.at(i).dtStart(), occurrences.at(i).dtStart());
+        EXPECT_EQ(pair.second.at(i).recurrenceId(), occurrences.at(i).recurrenceId());
+        EXPECT_EQ(pair.second.at(i).master()->summary(), occurrences.at(i).master()->summary());
+    }
+    //同一个原日程的实例共用解析后的原日程
+    EXPECT_EQ(pair.second.at(0).master().data(), pair.second.at(30).master().data());
+
+    //跨天的普通日程在每一天都显示
+    DScheduleOccurrence::Map occurrenceMap = DScheduleOccurrence::fromOccurrenceResult(DScheduleOccurrence::toListBinary(query, occurrences));
+    EXPECT_EQ(occurrenceMap.value(QDate(2023, 3, 2)).size(), 2);
+    DSchedule::Map scheduleMap = DScheduleOccurrence::toScheduleMap(occurrenceMap);
+    EXPECT_EQ(scheduleMap.value(QDate(2023, 3, 3)).size(), 2);
+}
+
+//年视图中10个每天重复的日程，比较完整日程和实例的内存占用
+TEST_F(test_dscheduleoccurrence, yearViewMemory)
+{
+    DSchedule::List scheduleList;
+    for (int i = 0; i < 10; ++i) {
+        scheduleList.append(createDailySchedule(QString("daily %1").arg(i)));
+    }
+    const QDateTime dtStart(QDate(2023, 1, 1), QTime(0, 0));
+    const QDateTime dtEnd(QDate(2023, 12, 31), QTime(23, 59));
+    //预先填充实例时间缓存，只比较实例本身的内存
+    DScheduleOccurrence::expand(scheduleList, dtStart, dtEnd);
+
+    qint64 heapBegin = heapUsed();
+    DSchedule::List schedules = DSchedule::expandOccurrences(scheduleList, dtStart, dtEnd);
+    const qint64 scheduleMemory = heapUsed() - heapBegin;
+
+    heapBegin = heapUsed();
+    DScheduleOccurrence::List occurrences = DScheduleOccurrence::expand(scheduleList, dtStart, dtEnd);
+    const qint64 occurrenceMemory = heapUsed() - heapBegin;
+
+    qInfo() << "year view with 10 daily schedules," << schedules.size() << "instances, DSchedule:" << scheduleMemory
+            << "bytes, DScheduleOccurrence:" << occurrenceMemory << "bytes";
+    EXPECT_EQ(schedules.size(), 3650);
+    EXPECT_EQ(occurrences.size(), schedules.size());
+    if (scheduleMemory > 0) {
+        EXPECT_LT(occurrenceMemory, scheduleMemory);
+    }
+}
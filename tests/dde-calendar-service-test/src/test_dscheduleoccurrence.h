@@ -0,0 +1,21 @@
+// SPDX-FileCopyrightText: 2019 - 2022 UnionTech Software Technology Co., Ltd.
+//
+// SPDX-License-Identifier: LGPL-3.0-or-later
+
+#ifndef TEST_DSCHEDULEOCCURRENCE_H
+#define TEST_DSCHEDULEOCCURRENCE_H
+
+#include "dscheduleoccurrence.h"
+#include "gtest/gtest.h"
+#include <QObject>
+
+class test_dscheduleoccurrence : public QObject, public::testing::Test
+{
+public:
+    test_dscheduleoccurrence();
+protected:
+    //创建每天重复的日程
+    DSchedule::Ptr createDailySchedule(const QString &summary);
+};
+
+#endif // TEST_DSCHEDULEOCCURRENCE_H
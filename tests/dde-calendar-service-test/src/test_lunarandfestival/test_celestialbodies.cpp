@@ -0,0 +1,75 @@
+// SPDX-FileCopyrightText: 2019 - 2022 UnionTech Software Technology Co., Ltd.
+//
+// SPDX-License-Identifier: LGPL-3.0-or-later
+
+#include "test_celestialbodies.h"
+
+test_celestialbodies::test_celestialbodies()
+{
+
+}
+
+//批量计算周期项与逐个计算结果完全一致
+TEST_F(test_celestialbodies, EvaluateVsopSeriesBatch)
+{
+    const double t[4] = {-0.1, -0.0123456789, 0.02, 0.1};
+    double result[4];
+    for (int i = 0; i < 6; ++i) {
+        EvaluateVsopSeries(EarthLSeries[i], t, result, 4);
+        for (int k = 0; k < 4; ++k) {
+            EXPECT_EQ(EvaluateVsopSeries(EarthLSeries[i], t[k]), result[k]);
+        }
+        EvaluateVsopSeries(EarthRSeries[i], t, result, 4);
+        for (int k = 0; k < 4; ++k) {
+            EXPECT_EQ(EvaluateVsopSeries(EarthRSeries[i], t[k]), result[k]);
+        }
+    }
+    for (int i = 0; i < 5; ++i) {
+        EvaluateVsopSeries(EarthBSeries[i], t, result, 4);
+        for (int k = 0; k < 4; ++k) {
+            EXPECT_EQ(EvaluateVsopSeries(EarthBSeries[i], t[k]), result[k]);
+        }
+    }
+}
+
+//批量计算的太阳地心视黄经与按原有步骤逐个计算的结果一致
+TEST_F(test_celestialbodies, GetEarthEclipticLongitudeForSunBatch)
+{
+    const double jd[5] = {2415020.5, 2440587.5, J2000, 2460000.25, 2488069.5};
+    double result[5];
+    GetEarthEclipticLongitudeForSun(jd, result, 5);
+    for (int k = 0; k < 5; ++k) {
+        double l = GetSunEclipticLongitudeForEarth(jd[k]);
+        double b = GetSunEclipticLatitudeForEarth(jd[k]);
+        l += CalcEarthLongitudeNutation(GetJulianCentury(jd[k]));
+        l += Vsop2Fk5LongitudeCorrection(l, b, jd[k]);
+        l = Mod2Pi(l + M_PI);
+        l -= SecondsToRadians(20.4898) / GetSunRadiusForEarth(jd[k]);
+        EXPECT_EQ(l, result[k]);
+        EXPECT_EQ(GetEarthEclipticLongitudeForSun(jd[k]), result[k]);
+    }
+}
+
+//与改为批量计算前的实现结果一致，取第1、6、13和25个节气
+TEST_F(test_celestialbodies, get25SolarTermJDsGolden)
+{
+    struct SolarTermJDs {
+        int year;
+        double jds[4];
+    };
+    const int indexes[4] = {0, 5, 12, 24};
+    const SolarTermJDs goldenList[] = {
+        {1900, {2415376.112252424, 2415450.0909463908, 2415557.9777008155, 2415741.3588241017}},
+        {1949, {2433273.0162389842, 2433346.9833185538, 2433454.8170468421, 2433638.2596175848}},
+        {2000, {2451900.4017327577, 2451974.3566434337, 2452082.1519363141, 2452265.6406664387}},
+        {2023, {2460300.9781248658, 2460374.9332651519, 2460482.7028696109, 2460666.223405032}},
+        {2099, {2488059.4217463741, 2488133.359395789, 2488241.0661102575, 2488424.6624351745}},
+    };
+    for (auto &golden : goldenList) {
+        QVector<double> jds = get25SolarTermJDs(golden.year, DongZhi);
+        ASSERT_EQ(25, jds.size());
+        for (int i = 0; i < 4; ++i) {
+            EXPECT_NEAR(golden.jds[i], jds.at(indexes[i]), 1e-9) << golden.year << " " << indexes[i];
+        }
+    }
+}
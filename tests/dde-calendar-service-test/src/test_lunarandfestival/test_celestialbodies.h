@@ -0,0 +1,18 @@
+// SPDX-FileCopyrightText: 2019 - 2022 UnionTech Software Technology Co., Ltd.
+//
+// SPDX-License-Identifier: LGPL-3.0-or-later
+
+#ifndef TEST_CELESTIALBODIES_H
+#define TEST_CELESTIALBODIES_H
+
+#include "method_interface.h"
+#include "gtest/gtest.h"
+#include <QObject>
+
+class test_celestialbodies : public QObject, public::testing::Test
+{
+public:
+    test_celestialbodies();
+};
+
+#endif // TEST_CELESTIALBODIES_H
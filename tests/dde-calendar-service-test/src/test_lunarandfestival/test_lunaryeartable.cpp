@@ -0,0 +1,58 @@
+// SPDX-FileCopyrightText: 2019 - 2022 UnionTech Software Technology Co., Ltd.
+//
+// SPDX-License-Identifier: LGPL-3.0-or-later
+
+#include "test_lunaryeartable.h"
+
+#include <QDate>
+
+test_lunaryeartable::test_lunaryeartable()
+{
+
+}
+
+//数据表范围内每一天的查表结果与天文算法计算结果一致
+TEST_F(test_lunaryeartable, matchesLunarCalendar)
+{
+    for (qint32 year = LunarYearTable::startYear(); year <= LunarYearTable::endYear(); ++year) {
+        const LunarYearData *data = LunarYearTable::yearData(year);
+        ASSERT_NE(nullptr, data) << year;
+        LunarCalendar *lunarCalendar = LunarCalendar::GetLunarCalendar(year);
+        for (QDate date(year, 1, 1); date.year() == year; date = date.addDays(1)) {
+            lunarInfo expected = lunarCalendar->SolarDayToLunarDay(date.month(), date.day());
+            lunarInfo actual = LunarYearTable::lunarDayFromData(*data, year, date.month(), date.day());
+            const QString dateStr = date.toString(Qt::ISODate);
+            ASSERT_EQ(expected.LunarYear, actual.LunarYear) << dateStr.toStdString();
+            ASSERT_EQ(expected.LunarMonthName, actual.LunarMonthName) << dateStr.toStdString();
+            ASSERT_EQ(expected.LunarMonthDays, actual.LunarMonthDays) << dateStr.toStdString();
+            ASSERT_EQ(expected.LunarDay, actual.LunarDay) << dateStr.toStdString();
+            ASSERT_EQ(expected.IsLeap, actual.IsLeap) << dateStr.toStdString();
+            ASSERT_EQ(expected.MonthZhi, actual.MonthZhi) << dateStr.toStdString();
+            ASSERT_EQ(expected.SolarTerm, actual.SolarTerm) << dateStr.toStdString();
+        }
+    }
+    LunarCalendar::LogOffEmptyData();
+}
+
+//数据表范围外使用天文算法计算
+TEST_F(test_lunaryeartable, outOfRange)
+{
+    const qint32 year = LunarYearTable::endYear() + 1;
+    EXPECT_EQ(nullptr, LunarYearTable::yearData(year));
+    EXPECT_EQ(nullptr, LunarYearTable::yearData(LunarYearTable::startYear() - 1));
+    lunarInfo expected = LunarCalendar::GetLunarCalendar(year)->SolarDayToLunarDay(2, 10);
+    lunarInfo actual = LunarYearTable::SolarDayToLunarDay(year, 2, 10);
+    EXPECT_TRUE(expected == actual);
+    EXPECT_EQ(expected.SolarTerm, actual.SolarTerm);
+}
+
+//2023年有闰二月
+TEST_F(test_lunaryeartable, leapMonth)
+{
+    //2023-03-22为闰二月初一
+    lunarInfo info = LunarYearTable::SolarDayToLunarDay(2023, 3, 22);
+    EXPECT_EQ(2023, info.LunarYear);
+    EXPECT_EQ(2, info.LunarMonthName);
+    EXPECT_TRUE(info.IsLeap);
+    EXPECT_EQ(1, info.LunarDay);
+}
@@ -0,0 +1,19 @@
+// SPDX-FileCopyrightText: 2019 - 2022 UnionTech Software Technology Co., Ltd.
+//
+// SPDX-License-Identifier: LGPL-3.0-or-later
+
+#ifndef TEST_LUNARYEARTABLE_H
+#define TEST_LUNARYEARTABLE_H
+
+#include "lunaryeartable.h"
+#include "lunarcalendar.h"
+#include "gtest/gtest.h"
+#include <QObject>
+
+class test_lunaryeartable : public QObject, public::testing::Test
+{
+public:
+    test_lunaryeartable();
+};
+
+#endif // TEST_LUNARYEARTABLE_H
@@ -0,0 +1,40 @@
+// SPDX-FileCopyrightText: 2019 - 2022 UnionTech Software Technology Co., Ltd.
+//
+// SPDX-License-Identifier: LGPL-3.0-or-later
+
+#include "test_pinyinsearch.h"
+
+test_pinyinsearch::test_pinyinsearch()
+{
+    search = pinyinsearch::getPinPinSearch();
+}
+
+//QString pinyinsearch::CreatePinyin(const QString &zh)
+TEST_F(test_pinyinsearch, CreatePinyin)
+{
+    //去掉音调并去重，没有拼音的字符被忽略
+    EXPECT_EQ(QString("[ni][hao]"), search->CreatePinyin("你好"));
+    EXPECT_EQ(QString("[ri][cheng][hui|kuai][yi]"), search->CreatePinyin("日程a会议1"));
+    EXPECT_EQ(QString(), search->CreatePinyin("abc"));
+}
+
+//QString pinyinsearch::CreatePinyinQuery(QString pinyin) const
+TEST_F(test_pinyinsearch, CreatePinyinQuery)
+{
+    EXPECT_EQ(QString("[%ni%][%hao%]"), search->CreatePinyinQuery("nihao"));
+    EXPECT_EQ(QString("[%zhuang%][%x%]"), search->CreatePinyinQuery("zhuangx"));
+    EXPECT_EQ(QString(), search->CreatePinyinQuery(""));
+}
+
+//bool pinyinsearch::PinyinMatch(const QString &zh, const QString &py) const
+TEST_F(test_pinyinsearch, PinyinMatch)
+{
+    EXPECT_TRUE(search->PinyinMatch("日程会议", "huiyi"));
+    EXPECT_TRUE(search->PinyinMatch("日程会议", "kuaiy"));
+    EXPECT_TRUE(search->PinyinMatch("日程a会议", "chenghui"));
+    EXPECT_FALSE(search->PinyinMatch("日程会议", "yihui"));
+    EXPECT_FALSE(search->PinyinMatch("日程", "richenghui"));
+    EXPECT_TRUE(search->CanQueryByPinyin("NiHao"));
+    EXPECT_FALSE(search->CanQueryByPinyin("ni hao"));
+    EXPECT_FALSE(search->CanQueryByPinyin(""));
+}
@@ -0,0 +1,20 @@
+// SPDX-FileCopyrightText: 2019 - 2022 UnionTech Software Technology Co., Ltd.
+//
+// SPDX-License-Identifier: LGPL-3.0-or-later
+
+#ifndef TEST_PINYINSEARCH_H
+#define TEST_PINYINSEARCH_H
+
+#include "pinyin/pinyinsearch.h"
+#include "gtest/gtest.h"
+#include <QObject>
+
+class test_pinyinsearch : public QObject, public::testing::Test
+{
+public:
+    test_pinyinsearch();
+protected:
+    pinyinsearch *search = nullptr;
+};
+
+#endif // TEST_PINYINSEARCH_H
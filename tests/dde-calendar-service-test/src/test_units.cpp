@@ -0,0 +1,35 @@
+// SPDX-FileCopyrightText: 2019 - 2022 UnionTech Software Technology Co., Ltd.
+//
+// SPDX-License-Identifier: LGPL-3.0-or-later
+
+#include "test_units.h"
+
+test_units::test_units()
+{
+}
+
+//TEXT类型属性的转义
+TEST_F(test_units, icsTextPropertyEscape)
+{
+    EXPECT_EQ(icsTextProperty("X-WR-CALNAME", "工作"), "X-WR-CALNAME:工作\r\n");
+    EXPECT_EQ(icsTextProperty("X-WR-CALNAME", "a\\b;c,d\r\ne\rf\ng"), "X-WR-CALNAME:a\\\\b\\;c\\,d\\ne\\nf\\ng\r\n");
+}
+
+//超过75字节的属性按UTF-8字符边界折行，去掉折行后与原内容一致
+TEST_F(test_units, icsTextPropertyFold)
+{
+    const QString value = QString("日程类型").repeated(20);
+    const QString property = icsTextProperty("X-DDE-CALENDAR-TYPE-NAME", value);
+    ASSERT_TRUE(property.endsWith("\r\n"));
+    const QStringList lines = property.left(property.size() - 2).split("\r\n");
+    ASSERT_GT(lines.size(), 1);
+    for (int i = 0; i < lines.size(); ++i) {
+        EXPECT_LE(lines.at(i).toUtf8().size(), 75);
+        if (i > 0) {
+            EXPECT_TRUE(lines.at(i).startsWith(' '));
+        }
+    }
+    QString unfolded = property;
+    unfolded.remove("\r\n ");
+    EXPECT_EQ(unfolded, "X-DDE-CALENDAR-TYPE-NAME:" + value + "\r\n");
+}
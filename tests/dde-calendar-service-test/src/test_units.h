@@ -0,0 +1,18 @@
+// SPDX-FileCopyrightText: 2019 - 2022 UnionTech Software Technology Co., Ltd.
+//
+// SPDX-License-Identifier: LGPL-3.0-or-later
+
+#ifndef TEST_UNITS_H
+#define TEST_UNITS_H
+
+#include "units.h"
+#include "gtest/gtest.h"
+#include <QObject>
+
+class test_units : public QObject, public::testing::Test
+{
+public:
+    test_units();
+};
+
+#endif // TEST_UNITS_H